@@ -0,0 +1,620 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * crcx-bench - measure the speed of libcrcx and libcrc3x
+ *
+ * The models used by the tests are run over messages of 1 byte to 1 GiB, in
+ * powers of 4. Each message is processed by crcx() with every kernel that is
+ * available on this CPU, and by crc3x::Crc::update() and
+ * crc3x::ModelCrc::update(), i.e. the runtime and the compile-time forms of a
+ * crc3x model. Before a kernel is measured, its CRC of "123456789" is compared
+ * with that of the table kernel.
+ *
+ * The results are written to stdout as JSON, one object per measurement:
+ *
+ *   {"api": "crcx", "kernel": "clmul", "model": "CRC-32/POSIX", "size": 4096,
+ *    "calls": 65536, "ns_per_call": 201.3, "gb_per_s": 20.35,
+ *    "cycles_per_byte": 0.14}
+ *
+ * Cycles are those of the time-stamp counter on x86, which counts at a
+ * constant rate rather than at the current core frequency. They are null on
+ * other CPUs.
+ *
+ * With --profile, the hardware performance counters of the fastest sample are
+ * added to each measurement using perf_event_open(2):
+ *
+ *   "counters": {"cycles_per_byte": 0.13, "ipc": 3.91,
+ *                "instructions_per_byte": 0.51, "l1d_misses_per_byte": 0.016,
+ *                "branch_misses_per_byte": 0.0001}
+ *
+ * Only user-space events of this process are counted, which a
+ * perf_event_paranoid level of 2 permits. Counters that cannot be opened,
+ * e.g. because of a higher level or a virtual machine without a PMU, are null.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CRCX_BENCH_TSC 1
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CRCX_BENCH_PERF 1
+#endif
+
+#include "crc3x/crc3x.h"
+#include "crcx/crcx.h"
+
+using namespace std;
+using namespace crc3x;
+
+// each measurement is the best of this many samples
+#define CRCX_BENCH_SAMPLES 3
+
+struct bench_model {
+  const char *name;
+  uint8_t n;
+  uintmax_t poly;
+  uintmax_t init;
+  uintmax_t fini;
+  bool reflect_input;
+  bool reflect_output;
+  // the CRC of data with crc3x::Crc and with crc3x::ModelCrc
+  uintmax_t (*crc3x)(const uint8_t *data, size_t len);
+  uintmax_t (*crc3x_model)(const uint8_t *data, size_t len);
+};
+
+template <class M> static uintmax_t crc3x_once(const uint8_t *data, size_t len) {
+  Crc<typename M::crc_type, M::width, M::poly> crc(M::init, M::xorout, M::refin,
+                                                   M::refout);
+  crc.update(data, data + len);
+  return crc.fini();
+}
+
+template <class M>
+static uintmax_t crc3x_model_once(const uint8_t *data, size_t len) {
+  ModelCrc<M> crc;
+  crc.update(data, data + len);
+  return crc.fini();
+}
+
+template <class M> static constexpr bench_model model(const char *name) {
+  return {name,     M::width,        M::poly,
+          M::init,  M::xorout,       M::refin,
+          M::refout, crc3x_once<M>, crc3x_model_once<M>};
+}
+
+// CRC-8, CRC-16/CCITT, CRC-24/BLE, CRC-32/POSIX and CRC-64/ECMA-182, as in
+// test/crcx-test.cpp
+static const bench_model bench_models[] = {
+    model<models::crc8_smbus>("CRC-8"),
+    model<models::crc16_xmodem>("CRC-16/CCITT"),
+    model<models::crc24_ble>("CRC-24/BLE"),
+    model<models::crc32_cksum>("CRC-32/POSIX"),
+    model<models::crc64_ecma_182>("CRC-64/ECMA-182"),
+};
+
+static const enum crcx_kernel kernels[] = {
+    CRCX_KERNEL_TABLE,
+    CRCX_KERNEL_SLICING,
+    CRCX_KERNEL_CLMUL,
+    CRCX_KERNEL_CRC32C,
+};
+
+struct bench_options {
+  vector<string> models;
+  vector<string> kernels;
+  size_t min = 1;
+  size_t max = size_t(1) << 30;
+  double time = 0.1;
+  bool profile = false;
+};
+
+enum bench_counter {
+  COUNTER_CYCLES,
+  COUNTER_INSTRUCTIONS,
+  COUNTER_L1D_MISSES,
+  COUNTER_BRANCH_MISSES,
+  COUNTERS,
+};
+
+struct bench_counters {
+  int fd[COUNTERS];
+  double value[COUNTERS]; ///< negative if the counter is not available
+};
+
+struct bench_result {
+  size_t calls;
+  double seconds;
+  uint64_t cycles;
+  double counters[COUNTERS];
+};
+
+static const char *bench_name = "crcx-bench";
+
+static void usage(FILE *fp) {
+  fprintf(fp,
+          "Usage: %s [OPTION]...\n"
+          "Measure the speed of CRC kernels and write the results as JSON.\n"
+          "\n"
+          "  -m, --model=NAME     only measure model NAME (repeatable)\n"
+          "  -k, --kernel=NAME    only measure kernel NAME, one of table, "
+          "slicing,\n"
+          "                       clmul, crc32c, crc3x or crc3x-model "
+          "(repeatable)\n"
+          "  -s, --min=SIZE       the smallest message size (default: 1)\n"
+          "  -S, --max=SIZE       the largest message size (default: 1 GiB)\n"
+          "  -t, --time=SECONDS   the minimum duration of each sample "
+          "(default: 0.1)\n"
+          "  -p, --profile        add hardware performance counters\n"
+          "  -h, --help           display this help and exit\n",
+          bench_name);
+}
+
+static bool selected(const vector<string> &names, const char *name) {
+  return names.empty() || names.end() != find(names.begin(), names.end(), name);
+}
+
+static uint64_t cycles() {
+#ifdef CRCX_BENCH_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+#ifdef CRCX_BENCH_PERF
+static const struct {
+  const char *name;
+  uint32_t type;
+  uint64_t config;
+} counter_events[COUNTERS] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"l1d-misses", PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+static int perf_event_open(perf_event_attr *attr) {
+  return int(syscall(__NR_perf_event_open, attr, 0, -1, -1, 0));
+}
+
+static int perf_event_paranoid() {
+  int level = -1;
+  FILE *fp = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+  if (nullptr != fp) {
+    if (1 != fscanf(fp, "%d", &level)) {
+      level = -1;
+    }
+    fclose(fp);
+  }
+  return level;
+}
+#endif
+
+/*
+ * Open the counters of this thread in user space. Each one is opened on its
+ * own rather than as a group, so that one event that is not supported does
+ * not prevent counting the others. If the PMU is oversubscribed, the counts
+ * are scaled by the time each event was actually counted.
+ *
+ * Return true if at least one counter is available.
+ */
+static bool counters_open(bench_counters &pmu) {
+  bool any = false;
+
+  for (int i = 0; i < COUNTERS; ++i) {
+    pmu.fd[i] = -1;
+    pmu.value[i] = -1;
+  }
+
+#ifdef CRCX_BENCH_PERF
+  for (int i = 0; i < COUNTERS; ++i) {
+    perf_event_attr attr = {};
+    attr.size = sizeof(attr);
+    attr.type = counter_events[i].type;
+    attr.config = counter_events[i].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    pmu.fd[i] = perf_event_open(&attr);
+    if (-1 == pmu.fd[i]) {
+      fprintf(stderr, "%s: %s: %s", bench_name, counter_events[i].name,
+              strerror(errno));
+      if (EACCES == errno || EPERM == errno) {
+        fprintf(stderr, " (perf_event_paranoid is %d)", perf_event_paranoid());
+      } else if (ENOENT == errno || EOPNOTSUPP == errno) {
+        fprintf(stderr, " (not supported by this CPU)");
+      }
+      fprintf(stderr, "\n");
+      continue;
+    }
+    any = true;
+  }
+#else
+  fprintf(stderr, "%s: performance counters are not supported\n", bench_name);
+#endif
+
+  return any;
+}
+
+static void counters_close(bench_counters &pmu) {
+#ifdef CRCX_BENCH_PERF
+  for (int i = 0; i < COUNTERS; ++i) {
+    if (-1 != pmu.fd[i]) {
+      close(pmu.fd[i]);
+      pmu.fd[i] = -1;
+    }
+  }
+#else
+  (void)pmu;
+#endif
+}
+
+static void counters_start(bench_counters *pmu) {
+#ifdef CRCX_BENCH_PERF
+  for (int i = 0; nullptr != pmu && i < COUNTERS; ++i) {
+    if (-1 != pmu->fd[i]) {
+      ioctl(pmu->fd[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(pmu->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#else
+  (void)pmu;
+#endif
+}
+
+static void counters_stop(bench_counters *pmu) {
+#ifdef CRCX_BENCH_PERF
+  for (int i = 0; nullptr != pmu && i < COUNTERS; ++i) {
+    // value, time enabled, time running
+    uint64_t v[3];
+    pmu->value[i] = -1;
+    if (-1 == pmu->fd[i]) {
+      continue;
+    }
+    ioctl(pmu->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    if (sizeof(v) == read(pmu->fd[i], v, sizeof(v)) && 0 != v[2]) {
+      pmu->value[i] = double(v[0]) * double(v[1]) / double(v[2]);
+    }
+  }
+#else
+  (void)pmu;
+#endif
+}
+
+// keeps the compiler from discarding CRCs that are never used
+static volatile uintmax_t sink;
+
+/*
+ * Double the number of calls until a sample takes at least @p time seconds,
+ * which also warms up the caches, then keep the fastest of a few samples.
+ */
+template <class F>
+static bench_result measure(F f, double time, bench_counters *pmu) {
+  using clock = chrono::steady_clock;
+  bench_result best = {0, 0, 0, {}};
+
+  for (size_t calls = 1, samples = 0; samples < CRCX_BENCH_SAMPLES;) {
+    uintmax_t x = 0;
+    counters_start(pmu);
+    const uint64_t c0 = cycles();
+    const auto t0 = clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+      x ^= f();
+    }
+    const chrono::duration<double> t = clock::now() - t0;
+    const uint64_t c = cycles() - c0;
+    counters_stop(pmu);
+    sink = x;
+
+    if (0 == samples && t.count() < time) {
+      calls *= 2;
+      continue;
+    }
+
+    const double per_call = t.count() / calls;
+    if (0 == samples++ || per_call < best.seconds / best.calls) {
+      best = {calls, t.count(), c, {}};
+      for (int i = 0; i < COUNTERS; ++i) {
+        best.counters[i] = nullptr != pmu ? pmu->value[i] : -1;
+      }
+    }
+  }
+
+  return best;
+}
+
+// print "name": x / y, or null if either counter is not available
+static void print_ratio(const char *name, double x, double y,
+                        const char *sep) {
+  if (x < 0 || y <= 0) {
+    printf("\"%s\": null%s", name, sep);
+  } else {
+    printf("\"%s\": %.6g%s", name, x / y, sep);
+  }
+}
+
+static void report(bool &first, const char *api, const char *kernel,
+                   const bench_model &m, size_t size, const bench_result &r,
+                   bool profile) {
+  const double ns = 1e9 * r.seconds / r.calls;
+  const double bytes = double(size) * r.calls;
+
+  printf("%s\n    {\"api\": \"%s\", \"kernel\": \"%s\", \"model\": \"%s\", "
+         "\"n\": %u, \"size\": %zu, \"calls\": %zu, \"ns_per_call\": %.3f, "
+         "\"gb_per_s\": %.4f, \"cycles_per_byte\": ",
+         first ? "" : ",", api, kernel, m.name, m.n, size, r.calls, ns,
+         bytes / r.seconds / 1e9);
+#ifdef CRCX_BENCH_TSC
+  printf("%.4f", double(r.cycles) / bytes);
+#else
+  printf("null");
+#endif
+  if (profile) {
+    auto c = r.counters;
+    printf(", \"counters\": {");
+    print_ratio("cycles_per_byte", c[COUNTER_CYCLES], bytes, ", ");
+    print_ratio("ipc", c[COUNTER_INSTRUCTIONS], c[COUNTER_CYCLES], ", ");
+    print_ratio("instructions_per_byte", c[COUNTER_INSTRUCTIONS], bytes,
+                ", ");
+    print_ratio("l1d_misses_per_byte", c[COUNTER_L1D_MISSES], bytes, ", ");
+    print_ratio("branch_misses_per_byte", c[COUNTER_BRANCH_MISSES], bytes,
+                "}");
+  }
+  printf("}");
+  fflush(stdout);
+  first = false;
+}
+
+static bool bench(const bench_options &opt, const uint8_t *buf,
+                  bench_counters *pmu) {
+  static uintmax_t slices[CRCX_SLICES_MAX][256];
+  static const uint8_t check[] = "123456789";
+  vector<size_t> sizes;
+  bool first = true;
+
+  for (size_t size = opt.min;; size *= 4) {
+    sizes.push_back(size);
+    if (size > opt.max / 4) {
+      break;
+    }
+  }
+
+  printf("{\n  \"context\": {\"cycles\": %s, \"counters\": ",
+#ifdef CRCX_BENCH_TSC
+         "\"tsc\""
+#else
+         "null"
+#endif
+  );
+#ifdef CRCX_BENCH_PERF
+  if (nullptr != pmu) {
+    const char *sep = "[";
+    for (int i = 0; i < COUNTERS; ++i) {
+      if (-1 != pmu->fd[i]) {
+        printf("%s\"%s\"", sep, counter_events[i].name);
+        sep = ", ";
+      }
+    }
+    printf("]");
+  } else
+#endif
+  {
+    printf("null");
+  }
+  printf("},\n  \"benchmarks\": [");
+
+  for (auto &m : bench_models) {
+    if (!selected(opt.models, m.name)) {
+      continue;
+    }
+
+    ::crcx_ctx ctx = {};
+    if (!::crcx_init(&ctx, m.n, m.poly, m.init, m.fini, m.reflect_input,
+                     m.reflect_output) ||
+        !::crcx_set_kernel(&ctx, CRCX_KERNEL_TABLE)) {
+      fprintf(stderr, "%s: %s: invalid model\n", bench_name, m.name);
+      return false;
+    }
+    ::crcx(&ctx, check, sizeof(check) - 1);
+    const uintmax_t expected = ::crcx_fini(&ctx);
+
+    for (auto kernel : kernels) {
+      const char *name = ::crcx_kernel_name(kernel);
+      if (!selected(opt.kernels, name)) {
+        continue;
+      }
+      if (CRCX_KERNEL_SLICING == kernel) {
+        ::crcx_set_kernel(&ctx, CRCX_KERNEL_TABLE);
+        ::crcx_generate_slices(&ctx, slices, sizeof(slices), CRCX_SLICES_MAX);
+      } else if (!::crcx_set_kernel(&ctx, kernel)) {
+        continue;
+      }
+
+      ::crcx(&ctx, check, sizeof(check) - 1);
+      if (expected != ::crcx_fini(&ctx)) {
+        fprintf(stderr, "%s: %s: %s: incorrect CRC\n", bench_name, m.name,
+                name);
+        return false;
+      }
+
+      for (auto size : sizes) {
+        auto r = measure(
+            [&] {
+              ::crcx(&ctx, buf, size);
+              return ::crcx_fini(&ctx);
+            },
+            opt.time, pmu);
+        report(first, "crcx", name, m, size, r, opt.profile);
+      }
+    }
+
+    const struct {
+      const char *name;
+      uintmax_t (*crc)(const uint8_t *data, size_t len);
+    } forms[] = {{"crc3x", m.crc3x}, {"crc3x-model", m.crc3x_model}};
+
+    for (auto &form : forms) {
+      if (!selected(opt.kernels, form.name)) {
+        continue;
+      }
+      if (expected != form.crc(check, sizeof(check) - 1)) {
+        fprintf(stderr, "%s: %s: %s: incorrect CRC\n", bench_name, m.name,
+                form.name);
+        return false;
+      }
+
+      for (auto size : sizes) {
+        auto r = measure([&] { return form.crc(buf, size); }, opt.time, pmu);
+        report(first, "crc3x", form.name, m, size, r, opt.profile);
+      }
+    }
+  }
+
+  printf("\n  ]\n}\n");
+
+  return true;
+}
+
+static bool parse_size(const char *s, size_t *size) {
+  char *end;
+  errno = 0;
+  unsigned long long v = strtoull(s, &end, 0);
+  switch (*end) {
+  case 'G':
+    v <<= 10;
+    /* fallthrough */
+  case 'M':
+    v <<= 10;
+    /* fallthrough */
+  case 'K':
+    v <<= 10;
+    ++end;
+    break;
+  }
+  *size = size_t(v);
+  return 0 == errno && end != s && '\0' == *end && 0 != v;
+}
+
+int main(int argc, char *argv[]) {
+  static const struct option options[] = {
+      {"model", required_argument, nullptr, 'm'},
+      {"kernel", required_argument, nullptr, 'k'},
+      {"min", required_argument, nullptr, 's'},
+      {"max", required_argument, nullptr, 'S'},
+      {"time", required_argument, nullptr, 't'},
+      {"profile", no_argument, nullptr, 'p'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0},
+  };
+  bench_options opt;
+  char *end;
+  int c;
+
+  bench_name = argv[0];
+
+  while (-1 != (c = getopt_long(argc, argv, "m:k:s:S:t:ph", options, nullptr))) {
+    switch (c) {
+    case 'm':
+      opt.models.push_back(optarg);
+      break;
+    case 'k':
+      opt.kernels.push_back(optarg);
+      break;
+    case 's':
+    case 'S':
+      if (!parse_size(optarg, 's' == c ? &opt.min : &opt.max)) {
+        fprintf(stderr, "%s: invalid size: %s\n", argv[0], optarg);
+        return EXIT_FAILURE;
+      }
+      break;
+    case 't':
+      opt.time = strtod(optarg, &end);
+      if (end == optarg || '\0' != *end || !(opt.time >= 0)) {
+        fprintf(stderr, "%s: invalid time: %s\n", argv[0], optarg);
+        return EXIT_FAILURE;
+      }
+      break;
+    case 'p':
+      opt.profile = true;
+      break;
+    case 'h':
+      usage(stdout);
+      return EXIT_SUCCESS;
+    default:
+      usage(stderr);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (optind != argc || opt.min > opt.max) {
+    usage(stderr);
+    return EXIT_FAILURE;
+  }
+
+  // pseudo-random data, so that no kernel benefits from a pattern
+  unique_ptr<uint8_t[]> buf(new (nothrow) uint8_t[opt.max]);
+  if (!buf) {
+    fprintf(stderr, "%s: %s\n", argv[0], strerror(ENOMEM));
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < opt.max; ++i) {
+    buf[i] = uint8_t(i * 2654435761u >> 24);
+  }
+
+  // without any counter, --profile only adds null values
+  bench_counters counters;
+  const bool pmu = opt.profile && counters_open(counters);
+
+  const bool ok = bench(opt, buf.get(), pmu ? &counters : nullptr);
+
+  if (pmu) {
+    counters_close(counters);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
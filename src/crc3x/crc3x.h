@@ -58,9 +58,16 @@
 #ifndef CRC3X_H_
 #define CRC3X_H_
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace crc3x {
 
@@ -87,30 +94,71 @@ template <typename T> static constexpr T reflect(const T &x, const size_t &M) {
 
   for (size_t i = 0; i < m; ++i) {
     bool bit = (x >> i) & 1;
-    y |= bit << ((m - 1) - i);
+    y |= T(T(bit) << ((m - 1) - i));
   }
 
   return y;
 }
 
 #if !defined(DOXYGEN_SHOULD_SKIP_THIS)
-// Adapted from https://stackoverflow.com/a/19016627
-template <size_t... Is> struct seq {};
-template <size_t N, size_t... Is>
-struct gen_seq : gen_seq<N - 1, N - 1, Is...> {};
-template <size_t... Is> struct gen_seq<0, Is...> : seq<Is...> {};
-
-template <class Generator, std::size_t... Is>
-constexpr auto generate_array_helper(Generator g, seq<Is...>)
-    -> std::array<decltype(g(std::size_t{})), sizeof...(Is)> {
-  return {{g(Is)...}};
-}
-
+// Iterative rather than recursive so that large tables remain well within
+// the compiler's constexpr evaluation limits
 template <std::size_t N, class Generator>
 constexpr auto generate_array(Generator g)
-    -> decltype(generate_array_helper(g, gen_seq<N>{})) {
-  return generate_array_helper(g, gen_seq<N>{});
+    -> std::array<decltype(g(std::size_t{})), N> {
+  std::array<decltype(g(std::size_t{})), N> a{};
+  for (std::size_t i = 0; i < N; ++i) {
+    a[i] = g(i);
+  }
+  return a;
 }
+
+/// A lookup table used to reflect the bits of a byte
+inline constexpr std::array<uint8_t, 256> reflected_bytes =
+    generate_array<256>([](std::size_t x) { return uint8_t(reflect(x, 8)); });
+
+/// True if @p V is a byte that may be read as a uint8_t
+template <class V>
+inline constexpr bool is_byte =
+    (1 == sizeof(V) && std::is_integral_v<V> && !std::is_same_v<V, bool>) ||
+    std::is_same_v<V, std::byte>;
+
+/**
+ * True if @p I iterates over contiguous bytes
+ *
+ * C++17 has no way to tell, so apart from pointers only the iterators of
+ * std::vector, std::string and std::string_view are recognized. With C++20,
+ * any contiguous iterator is.
+ */
+template <class I, class V = typename std::iterator_traits<I>::value_type>
+inline constexpr bool is_contiguous_bytes =
+    is_byte<V> && (std::is_pointer_v<I> ||
+#if defined(__cpp_lib_concepts)
+                   std::contiguous_iterator<I> ||
+#endif
+                   std::is_same_v<I, typename std::vector<V>::iterator> ||
+                   std::is_same_v<I, typename std::vector<V>::const_iterator> ||
+                   std::is_same_v<I, std::string::iterator> ||
+                   std::is_same_v<I, std::string::const_iterator> ||
+                   std::is_same_v<I, std::string_view::const_iterator>);
+
+/**
+ * True if @p R is a contiguous range of bytes, i.e. it provides data() and
+ * size(), other than an array of char
+ *
+ * Arrays of char are usually string literals, which would include the
+ * terminating NUL. They are handled as std::string_view instead.
+ */
+template <class R, class = void>
+inline constexpr bool is_byte_range = false;
+template <class R>
+inline constexpr bool is_byte_range<
+    R, std::void_t<decltype(std::data(std::declval<const R &>())),
+                   decltype(std::size(std::declval<const R &>()))>> =
+    is_byte<std::remove_cv_t<std::remove_pointer_t<
+        decltype(std::data(std::declval<const R &>()))>>> &&
+    !(std::is_array_v<R> &&
+      std::is_same_v<std::remove_cv_t<std::remove_extent_t<R>>, char>);
 #endif /* !defined(DOXYGEN_SHOULD_SKIP_THIS) */
 
 /**
@@ -139,7 +187,6 @@ struct generator {
   static constexpr void checkTemplateParameters() {
     static_assert(std::is_arithmetic<T>::value, "Not an arithmetic type");
     static_assert(0 != N, "CRC length must be non-zero");
-    static_assert(0 == N % 8, "CRC length must be a multiple of 8");
     static_assert(N <= 8 * sizeof(T), "CRC length must be <= 8 * sizeof(T)");
     static_assert(T(0) != polynomial, "CRC polynomial must be non-zero");
     static_assert(T(0) == (polynomial & (~mask())),
@@ -162,32 +209,297 @@ struct generator {
     }
   }
 
+  /**
+   * Return the number of bits in the register, i.e. @p N rounded up to a
+   * multiple of 8
+   *
+   * CRCs that are not a multiple of 8 bits in length are kept left-aligned
+   * in the register, so that one byte is processed per table lookup
+   * regardless of @p N.
+   */
+  static constexpr std::size_t width() { return (N + 7) / 8 * 8; }
+
+  /// Return the number of bits that the CRC is shifted left in the register
+  static constexpr std::size_t shift() { return width() - N; }
+
+  /// Return a mask with all of the bits in the register set
+  static constexpr T registerMask() {
+    if (width() == 8 * sizeof(T)) {
+      return T(-1);
+    } else {
+      return T((1ULL << width()) - 1);
+    }
+  }
+
   /// Perform one CRC table entry for for array position, @p x
   static constexpr T func(T x) {
 
     checkTemplateParameters();
 
-    T index = (x << (N - 8)) & mask();
+    constexpr T top = T(1ULL << (width() - 1));
+    constexpr T poly = T(polynomial << shift());
+
+    T index = T(x << (width() - 8)) & registerMask();
     for (auto bit = 0; bit < 8; ++bit) {
-      if (0 != (index & msb())) {
+      if (0 != (index & top)) {
         index <<= 1;
-        index ^= polynomial;
+        index ^= poly;
       } else {
         index <<= 1;
       }
     }
 
-    return index & mask();
+    return index & registerMask();
+  }
+
+  /**
+   * Generate @p S tables for slicing-by-@p S
+   *
+   * Table @p k holds the CRC of each possible byte followed by @p k zero
+   * bytes, so table 0 is identical to the table produced by @ref func. Like
+   * that table, entries are left-aligned in the register (see @ref width).
+   * Processing @p S bytes per iteration then only requires one lookup per
+   * byte without a dependency on the previous lookup.
+   *
+   * @tparam S  the number of tables to generate
+   *
+   * @see <a
+   * href="https://en.wikipedia.org/wiki/Computation_of_cyclic_redundancy_checks#Multi-bit_computation_using_multiple_tables">Computation
+   * of cyclic redundancy checks: Multi-bit computation using multiple
+   * tables</a>
+   */
+  template <std::size_t S>
+  static constexpr std::array<std::array<T, 256>, S> slices() {
+    static_assert(0 != S, "At least one table is required");
+
+    std::array<std::array<T, 256>, S> tables{};
+
+    for (std::size_t i = 0; i < 256; ++i) {
+      tables[0][i] = func(T(i));
+    }
+
+    for (std::size_t k = 1; k < S; ++k) {
+      for (std::size_t i = 0; i < 256; ++i) {
+        // append one zero byte to the message described by tables[k - 1][i]
+        const T crc = tables[k - 1][i];
+        T next = 0;
+        if constexpr (width() > 8) {
+          next = T(crc << 8) & registerMask();
+        }
+        tables[k][i] = next ^ tables[0][uint8_t(crc >> (width() - 8))];
+      }
+    }
+
+    return tables;
+  }
+
+  /**
+   * Perform one entry of the reflected CRC table for array position @p x
+   *
+   * The reflected table processes input bits least-significant first, with
+   * the reflected polynomial and the CRC right-aligned in the register. It
+   * is equal to the table of @ref func with the bits of each index and each
+   * entry reflected, so input bytes do not need to be reflected.
+   */
+  static constexpr T reflected_func(T x) {
+
+    checkTemplateParameters();
+
+    constexpr T poly = reflect(T(polynomial), N);
+
+    T crc = T(x & 0xff);
+    for (auto bit = 0; bit < 8; ++bit) {
+      if (0 != (crc & 1)) {
+        crc = T(crc >> 1) ^ poly;
+      } else {
+        crc = T(crc >> 1);
+      }
+    }
+
+    return crc;
+  }
+
+  /**
+   * Generate @p S reflected tables for slicing-by-@p S
+   *
+   * This is @ref slices for @ref reflected_func. Table @p k holds the
+   * reflected CRC of each possible byte followed by @p k zero bytes.
+   *
+   * @tparam S  the number of tables to generate
+   */
+  template <std::size_t S>
+  static constexpr std::array<std::array<T, 256>, S> reflected_slices() {
+    static_assert(0 != S, "At least one table is required");
+
+    std::array<std::array<T, 256>, S> tables{};
+
+    for (std::size_t i = 0; i < 256; ++i) {
+      tables[0][i] = reflected_func(T(i));
+    }
+
+    for (std::size_t k = 1; k < S; ++k) {
+      for (std::size_t i = 0; i < 256; ++i) {
+        const T crc = tables[k - 1][i];
+        tables[k][i] = T(crc >> 8) ^ tables[0][uint8_t(crc)];
+      }
+    }
+
+    return tables;
   }
 };
 
+#if !defined(DOXYGEN_SHOULD_SKIP_THIS)
+template <class M> class ModelCrc;
+
+/// The tables of @ref ModelCrc for models that reflect their input
+template <typename T, std::size_t N, std::uintmax_t polynomial>
+inline constexpr auto reflected_tables =
+    generator<T, N, polynomial>::template reflected_slices<16>();
+#endif /* !defined(DOXYGEN_SHOULD_SKIP_THIS) */
+
+/**
+ * The update functions common to @ref Crc and @ref ModelCrc
+ *
+ * @p Derived provides @p update(uint8_t) along with the protected
+ * @p update_bytes(const B *, std::size_t), which processes contiguous bytes
+ * of a one-byte type @p B, and @p update_partial(uint8_t, std::size_t),
+ * which processes the first 1 to 7 bits of a byte.
+ *
+ * @tparam Derived  the CRC class
+ */
+template <class Derived> class basic_crc {
+
+public:
+  /**
+   * Update the CRC calculation multiple times
+   *
+   * Iterators over contiguous bytes, such as pointers and the iterators of
+   * @p std::vector<uint8_t> and @p std::string, are processed like
+   * @ref update(const void *, std::size_t). Other iterators are processed
+   * one element at a time.
+   *
+   * @param begin  the beginning of the data with which the CRC should be
+   * updated
+   * @param end    the end of the data with which the CRC should be updated
+   */
+  template <class iterator_type>
+  constexpr void update(iterator_type begin, iterator_type end) {
+    if constexpr (is_contiguous_bytes<iterator_type>) {
+      if (begin != end) {
+        self().update_bytes(std::addressof(*begin), std::size_t(end - begin));
+      }
+    } else {
+      for (auto it = begin; it != end; it++) {
+        self().update(*it);
+      }
+    }
+  }
+
+  /**
+   * Update the CRC calculation with @p len contiguous bytes
+   *
+   * The bytes are processed 16 or 8 at a time with slicing tables. Whether
+   * the input is reflected is decided once per call rather than per byte.
+   *
+   * Unlike the other overloads, this one cannot be used in constant
+   * expressions, because they do not allow casts from @p void *.
+   *
+   * @param data  the data with which the CRC should be updated
+   * @param len   the number of bytes of @p data
+   */
+  void update(const void *data, std::size_t len) {
+    self().update_bytes(static_cast<const uint8_t *>(data), len);
+  }
+
+  /**
+   * Update the CRC calculation with the characters of @p s
+   *
+   * String literals are processed up to, but not including, the terminating
+   * NUL.
+   *
+   * @param s  the data with which the CRC should be updated
+   */
+  constexpr void update(std::string_view s) {
+    self().update_bytes(s.data(), s.size());
+  }
+
+  /**
+   * Update the CRC calculation with a contiguous range of bytes
+   *
+   * @p range is any type that provides @p data() and @p size(), e.g. a
+   * @p std::vector<uint8_t>, a @p std::string, a @p std::array or an array of
+   * @p uint8_t.
+   *
+   * @param range  the data with which the CRC should be updated
+   */
+  template <class range_type,
+            std::enable_if_t<is_byte_range<range_type>, int> = 0>
+  constexpr void update(const range_type &range) {
+    self().update_bytes(std::data(range), std::size(range));
+  }
+
+  /**
+   * Update the CRC calculation with a sequence of contiguous segments
+   *
+   * Each element of @p segments is a contiguous range of bytes, e.g. a
+   * @p std::string_view, a @p std::vector<uint8_t> or any type that provides
+   * @p data() and @p size(). The segments are processed in turn with the
+   * slicing tables, without being copied.
+   *
+   * @code{.cpp}
+   * std::vector<std::string_view> segments = {"1234", "56789"};
+   * crc.update(segments);
+   * @endcode
+   *
+   * @param segments  the data with which the CRC should be updated
+   */
+  template <class range_type,
+            class = std::void_t<decltype(std::data(
+                *std::begin(std::declval<const range_type &>())))>>
+  constexpr void update(const range_type &segments) {
+    for (const auto &segment : segments) {
+      static_assert(is_byte<std::remove_cv_t<
+                        std::remove_pointer_t<decltype(std::data(segment))>>>,
+                    "Segments must consist of bytes");
+      self().update_bytes(std::data(segment), std::size(segment));
+    }
+  }
+
+  /**
+   * Update the CRC calculation with @p nbits bits of @p data
+   *
+   * Whole bytes are processed like @ref update. The remaining @p nbits % 8
+   * bits are taken from the following byte, starting from its
+   * most-significant bit, or from its least-significant bit if the input is
+   * reflected. They are processed with a single table lookup.
+   *
+   * @param data   the data with which the CRC should be updated
+   * @param nbits  the number of bits of @p data to process
+   */
+  constexpr void update_bits(const uint8_t *data, std::size_t nbits) {
+    self().update_bytes(data, nbits / 8);
+    if (0 != nbits % 8) {
+      self().update_partial(data[nbits / 8], nbits % 8);
+    }
+  }
+
+protected:
+  /// Return this object as a @p Derived
+  constexpr Derived &self() { return static_cast<Derived &>(*this); }
+};
+
 /**
  * The main LibCRC3x class
  *
  * This structure contains all of the necessary context to compute the cyclic
  * redundancy check for binary data.
- * The "normal" polynomial representation is used. It only works for CRC's that
- * are a multiple of 8 bits in length.
+ * The "normal" polynomial representation is used. It works for CRC's of any
+ * length from 1 to 8 * sizeof(@p T) bits. CRCs that are not a multiple of 8
+ * bits in length are kept left-aligned in @p Crc.lfsr so that they are
+ * processed a byte at a time, like any other.
+ *
+ * The parameters of the model other than the polynomial are set at runtime.
+ * When all of them are known at compile time, @ref ModelCrc is faster.
  *
  * @tparam N           The length of the CRC in bits
  * @tparam T           The storage type for the CRC lookup table
@@ -199,7 +511,8 @@ struct generator {
  * href="https://en.wikipedia.org/wiki/Cyclic_redundancy_check#Polynomial_representations_of_cyclic_redundancy_checks">Polynomial
  * representations of cyclic redundancy checks</a>
  */
-template <typename T, std::size_t N, T polynomial> class Crc {
+template <typename T, std::size_t N, T polynomial>
+class Crc : public basic_crc<Crc<T, N, polynomial>> {
 
 public:
   /**
@@ -214,10 +527,13 @@ public:
    * @param reflectOutput  perform a bitwise reversal of the result of the CRC
    * calculation
    */
-  Crc(T initializer, T finalizer, bool reflectInput, bool reflectOutput)
+  constexpr Crc(T initializer, T finalizer, bool reflectInput,
+                bool reflectOutput)
       : initializer(initializer), finalizer(finalizer),
         reflectInput(reflectInput), reflectOutput(reflectOutput),
-        lfsr(initializer) {}
+        lfsr(align(initializer)) {}
+
+  using basic_crc<Crc>::update;
 
   /**
    * Update the CRC calculation with new @p data
@@ -227,68 +543,179 @@ public:
    *
    * @param data  the data with which the CRC should be updated
    */
-  void update(uint8_t data) {
+  constexpr void update(uint8_t data) {
+    if (reflectInput) {
+      lfsr = feed_byte<true>(lfsr, data);
+    } else {
+      lfsr = feed_byte<false>(lfsr, data);
+    }
+  }
+
+  /**
+   * Finalize a CRC calculation
+   *
+   * This function xor's the @p Crc.lfsr with the value specified by @p
+   * Crc.finalizer.
+   *
+   * This function reflects the output if specified by @p Crc.reflectOutput.
+   * 
+   * This function also re-initializes the @p Crc.lfsr with the value
+   * specified by @p Crc.initializer.
+   * 
+   * @return The result of the CRC algorithm
+   */
+  constexpr T fini() {
+    T result = T(lfsr >> generator<T, N, polynomial>::shift());
+    result ^= finalizer;
+    result &= generator<T, N, polynomial>::mask();
 
+    if (reflectOutput) {
+      result = reflect(result, N);
+    }
+
+    lfsr = align(initializer);
+    return result;
+  }
+
+protected:
+  friend class basic_crc<Crc>;
+  template <class M> friend class ModelCrc;
+
+  /// the number of bits in the register, see @ref generator::width
+  static constexpr std::size_t W = generator<T, N, polynomial>::width();
+
+  /**
+   * Update the CRC calculation with @p len bytes of type @p B
+   *
+   * @p B is uint8_t, char, std::byte or another one-byte integer, so that
+   * e.g. a std::string_view is processed without a reinterpret_cast, which
+   * is not allowed in constant expressions.
+   */
+  template <class B>
+  constexpr void update_bytes(const B *data, std::size_t len) {
     if (reflectInput) {
-      data = reflect(data, 8);
+      lfsr = feed_block<true>(lfsr, data, data + len);
+    } else {
+      lfsr = feed_block<false>(lfsr, data, data + len);
+    }
+  }
+
+  /// Update the CRC calculation with the first @p nbits bits of @p data
+  constexpr void update_partial(uint8_t data, std::size_t nbits) {
+
+    if (reflectInput) {
+      data = reflected_bytes[data];
+    }
+
+    lfsr = feed_bits(lfsr, data, nbits);
+  }
+
+  /// Return @p lfsr updated with one byte, reflected if @p reflected
+  template <bool reflected>
+  static constexpr T feed_byte(T lfsr, uint8_t data) {
+
+    if constexpr (reflected) {
+      data = reflected_bytes[data];
     }
 
     // https://en.wikipedia.org/wiki/Computation_of_cyclic_redundancy_checks#Multi-bit_computation
-    uint8_t upper_byte = (lfsr >> (N - 8));
+    uint8_t upper_byte = (lfsr >> (W - 8));
     uint8_t idx = data ^ upper_byte;
 
-    if (N <= 8) {
+    if (W <= 8) {
       lfsr = 0;
     } else {
       lfsr <<= 8;
     }
-    lfsr &= generator<T, N, polynomial>::mask();
+    lfsr &= generator<T, N, polynomial>::registerMask();
     lfsr ^= table[idx];
+
+    return lfsr;
+  }
+
+  /// Return @p lfsr updated with the bytes from @p begin to @p end
+  template <bool reflected, class B>
+  static constexpr T feed_block(T lfsr, const B *begin, const B *end) {
+    begin = feed_slices<16, reflected>(lfsr, begin, end);
+    begin = feed_slices<8, reflected>(lfsr, begin, end);
+    for (; begin != end; ++begin) {
+      lfsr = feed_byte<reflected>(lfsr, uint8_t(*begin));
+    }
+    return lfsr;
+  }
+
+  /// Shift @p x left into the most-significant bits of the register
+  static constexpr T align(T x) {
+    return T(T(x & generator<T, N, polynomial>::mask())
+             << generator<T, N, polynomial>::shift());
   }
 
   /**
-   * Update the CRC calculation multiple times
+   * Return @p lfsr updated with the first @p nbits (1 to 7) bits of @p data,
+   * starting from its most-significant bit
    *
-   * @param begin  the beginning of the data with which the CRC should be
-   * updated
-   * @param end    the end of the data with which the CRC should be updated
+   * Leading zero bits do not change a zero register, so the table entry of a
+   * byte whose first 8 - @p nbits bits are zero is the CRC of its last
+   * @p nbits bits.
    */
-  template <class iterator_type>
-  void update(iterator_type begin, iterator_type end) {
-    for (auto it = begin; it != end; it++) {
-      update(*it);
-    }
+  static constexpr T feed_bits(T lfsr, uint8_t data, std::size_t nbits) {
+
+    uint8_t idx = uint8_t(lfsr >> (W - nbits)) ^ uint8_t(data >> (8 - nbits));
+
+    lfsr = T(lfsr << nbits) & generator<T, N, polynomial>::registerMask();
+    lfsr ^= table[idx];
+
+    return lfsr;
   }
 
   /**
-   * Finalize a CRC calculation
+   * Update @p lfsr @p S bytes at a time
    *
-   * This function xor's the @p Crc.lfsr with the value specified by @p
-   * Crc.finalizer.
+   * @tparam reflected  reflect each input byte
    *
-   * This function reflects the output if specified by @p Crc.reflectOutput.
-   * 
-   * This function also re-initializes the @p Crc.lfsr with the value
-   * specified by @p Crc.initializer.
-   * 
-   * @return The result of the CRC algorithm
+   * @param lfsr   the register to update
+   * @param begin  the beginning of the data with which the CRC should be
+   * updated
+   * @param end    the end of the data with which the CRC should be updated
+   * @return       the beginning of the remaining (fewer than @p S) bytes
    */
-  T fini() {
-    T result;
-    lfsr ^= finalizer;
-    lfsr &= generator<T, N, polynomial>::mask();
+  template <std::size_t S, bool reflected, class B>
+  static constexpr const B *feed_slices(T &lfsr, const B *begin,
+                                        const B *end) {
 
-    if (reflectOutput) {
-      result = reflect(lfsr, N);
-    } else {
-      result = lfsr;
+    static_assert(S <= std::tuple_size<decltype(slices)>::value,
+                  "Not enough slicing tables");
+
+    constexpr std::size_t nbytes = W / 8;
+    constexpr std::size_t m = std::min(nbytes, S);
+
+    for (; std::size_t(end - begin) >= S; begin += S) {
+      T crc = 0;
+      if constexpr (8 * S < W) {
+        crc = T(lfsr << (8 * S)) & generator<T, N, polynomial>::registerMask();
+      }
+      std::size_t i = 0;
+      for (; i < m; ++i) {
+        uint8_t data = uint8_t(begin[i]);
+        if constexpr (reflected) {
+          data = reflected_bytes[data];
+        }
+        data ^= uint8_t(lfsr >> (W - 8 * (i + 1)));
+        crc ^= slices[S - 1 - i][data];
+      }
+      for (; i < S; ++i) {
+        uint8_t data = uint8_t(begin[i]);
+        if constexpr (reflected) {
+          data = reflected_bytes[data];
+        }
+        crc ^= slices[S - 1 - i][data];
+      }
+      lfsr = crc;
     }
 
-    lfsr = initializer;
-    return result;
+    return begin;
   }
 
-protected:
   /// the initial value stored in the @p Crc.lfsr
   const T initializer;
   /// the final value xor'ed with the @p Crc.lfsr
@@ -318,8 +745,276 @@ public:
    */
   inline static constexpr auto table =
       generate_array<256>(&generator<T, N, polynomial>::func);
+
+  /**
+   * Lookup tables for slicing-by-8 and slicing-by-16
+   *
+   * Like @ref Crc.table, these are generated at compile time. The first
+   * table is identical to @ref Crc.table and table @p k accounts for @p k
+   * zero bytes following the input byte.
+   */
+  inline static constexpr auto slices =
+      generator<T, N, polynomial>::template slices<16>();
+};
+
+/**
+ * A CRC class for a model whose parameters are all compile-time constants
+ *
+ * @p M is a policy with the parameters of the model, normally a @ref Model.
+ * It provides @p crc_type, @p width, @p poly, @p init, @p xorout, @p refin
+ * and @p refout, named as in the catalogue.
+ *
+ * Unlike @ref Crc, the hot loops have no branches on the parameters and the
+ * object only holds the register. Models that reflect their input use
+ * reflected tables (see @ref generator::reflected_slices), so that input
+ * bytes are not reflected either. Their register holds the reflected CRC,
+ * right-aligned. Other models work like @ref Crc and share its tables.
+ *
+ * @code{.cpp}
+ * crc3x::ModelCrc<crc3x::models::crc32_iso_hdlc> crc;
+ * crc.update(data.begin(), data.end());
+ * uint32_t result = crc.fini();
+ * @endcode
+ *
+ * @tparam M  the model
+ */
+template <class M> class ModelCrc : public basic_crc<ModelCrc<M>> {
+
+  using T = typename M::crc_type;
+  static constexpr std::size_t N = M::width;
+  using gen = generator<T, N, M::poly>;
+  using normal = Crc<T, N, M::poly>;
+
+public:
+  /// the type of the result
+  using crc_type = T;
+
+  /// Create a ModelCrc instance
+  constexpr ModelCrc() : lfsr(initial) {}
+
+  using basic_crc<ModelCrc>::update;
+
+  /**
+   * Update the CRC calculation with new @p data
+   *
+   * @param data  the data with which the CRC should be updated
+   */
+  constexpr void update(uint8_t data) {
+    if constexpr (M::refin) {
+      lfsr = feed_byte(lfsr, data);
+    } else {
+      lfsr = normal::template feed_byte<false>(lfsr, data);
+    }
+  }
+
+  /**
+   * Finalize a CRC calculation
+   *
+   * Like @ref Crc.fini, this xor's the CRC with @p M::xorout, reflects the
+   * result if @p M::refout is set and re-initializes the register.
+   *
+   * @return The result of the CRC algorithm
+   */
+  constexpr T fini() {
+    T result = 0;
+
+    if constexpr (M::refin && M::refout) {
+      result = T(lfsr ^ reflect(xorout, N));
+    } else if constexpr (M::refin) {
+      result = T(reflect(lfsr, N) ^ xorout);
+    } else {
+      result = T(T(lfsr >> gen::shift()) ^ xorout) & gen::mask();
+      if constexpr (M::refout) {
+        result = reflect(result, N);
+      }
+    }
+
+    lfsr = initial;
+    return result;
+  }
+
+protected:
+  friend class basic_crc<ModelCrc>;
+
+  /// the final value xor'ed with the CRC
+  static constexpr T xorout = T(M::xorout & gen::mask());
+
+  /// the initial value of @p ModelCrc.lfsr
+  static constexpr T initial = M::refin ? reflect(T(M::init & gen::mask()), N)
+                                        : normal::align(M::init);
+
+  /// Update the CRC calculation with @p len bytes of type @p B
+  template <class B>
+  constexpr void update_bytes(const B *data, std::size_t len) {
+    if constexpr (M::refin) {
+      const B *end = data + len;
+      data = feed_slices<16>(lfsr, data, end);
+      data = feed_slices<8>(lfsr, data, end);
+      for (; data != end; ++data) {
+        lfsr = feed_byte(lfsr, uint8_t(*data));
+      }
+    } else {
+      lfsr = normal::template feed_block<false>(lfsr, data, data + len);
+    }
+  }
+
+  /// Update the CRC calculation with the first @p nbits bits of @p data
+  constexpr void update_partial(uint8_t data, std::size_t nbits) {
+    if constexpr (M::refin) {
+      // the last nbits bits of a byte that starts with zeros, reflected
+      const uint8_t idx = uint8_t((lfsr ^ data) << (8 - nbits));
+      lfsr = T(lfsr >> nbits) ^ tables()[0][idx];
+    } else {
+      lfsr = normal::feed_bits(lfsr, data, nbits);
+    }
+  }
+
+  /// The reflected tables, which are only generated if @p M::refin is set
+  static constexpr const auto &tables() {
+    return reflected_tables<T, N, M::poly>;
+  }
+
+  /// Return @p lfsr updated with one byte, least-significant bit first
+  static constexpr T feed_byte(T lfsr, uint8_t data) {
+    return T(lfsr >> 8) ^ tables()[0][uint8_t(lfsr) ^ data];
+  }
+
+  /**
+   * Update @p lfsr @p S bytes at a time, least-significant bit first
+   *
+   * @return the beginning of the remaining (fewer than @p S) bytes
+   */
+  template <std::size_t S, class B>
+  static constexpr const B *feed_slices(T &lfsr, const B *begin,
+                                        const B *end) {
+
+    constexpr std::size_t nbytes = (N + 7) / 8;
+    constexpr std::size_t m = std::min(nbytes, S);
+
+    for (; std::size_t(end - begin) >= S; begin += S) {
+      T crc = 0;
+      if constexpr (8 * S < N) {
+        crc = T(lfsr >> (8 * S));
+      }
+      std::size_t i = 0;
+      for (; i < m; ++i) {
+        const uint8_t data = uint8_t(begin[i]) ^ uint8_t(lfsr >> (8 * i));
+        crc ^= tables()[S - 1 - i][data];
+      }
+      for (; i < S; ++i) {
+        crc ^= tables()[S - 1 - i][uint8_t(begin[i])];
+      }
+      lfsr = crc;
+    }
+
+    return begin;
+  }
+
+  /// the modeled linear feedback shift register
+  T lfsr;
+};
+
+/**
+ * A CRC model, i.e. all of the parameters of a CRC algorithm
+ *
+ * The parameters are those of the <a
+ * href="https://reveng.sourceforge.io/crc-catalogue/">Catalogue of
+ * parametrised CRC algorithms</a>. A model is the policy of a
+ * @ref ModelCrc, which @ref compute and @ref Model.crc create. For
+ * parameters only known at runtime, use @ref Crc instead.
+ *
+ * @code{.cpp}
+ * using crc32 = Model<uint32_t, 32, 0x04c11db7, 0xffffffff, 0xffffffff,
+ *                     true, true>;
+ * static_assert(crc3x::compute<crc32>("123456789") == 0xcbf43926);
+ * @endcode
+ *
+ * @tparam T               the storage type for the CRC
+ * @tparam N               the number of bits in the CRC
+ * @tparam polynomial      the CRC polynomial
+ * @tparam initializer     the initial value of the register
+ * @tparam finalizer       the final value xor'ed with the register
+ * @tparam reflectInput    perform a bitwise reversal of each input byte
+ * @tparam reflectOutput   perform a bitwise reversal of the result
+ */
+template <typename T, std::size_t N, T polynomial, T initializer, T finalizer,
+          bool reflectInput, bool reflectOutput>
+struct Model {
+  /// the type of the result
+  using crc_type = T;
+  /// the number of bits in the CRC
+  static constexpr std::size_t width = N;
+  /// the CRC polynomial
+  static constexpr T poly = polynomial;
+  /// the initial value of the register
+  static constexpr T init = initializer;
+  /// the final value xor'ed with the register
+  static constexpr T xorout = finalizer;
+  /// perform a bitwise reversal of each input byte
+  static constexpr bool refin = reflectInput;
+  /// perform a bitwise reversal of the result
+  static constexpr bool refout = reflectOutput;
+
+  /// the type of the CRC object that implements the model
+  using crc_class = ModelCrc<Model>;
+
+  /// Create a @ref ModelCrc that implements the model
+  static constexpr crc_class crc() { return crc_class(); }
 };
 
+/**
+ * Compute the CRC of @p data with @p M
+ *
+ * @p data is anything accepted by one of the @ref basic_crc.update overloads,
+ * e.g. a string literal, a @p std::string_view, a @p std::array<uint8_t, n>
+ * or a pair of iterators. When @p data is a constant, so is the CRC:
+ *
+ * @code{.cpp}
+ * constexpr auto crc = crc3x::compute<crc3x::models::crc16_xmodem>("hello");
+ * @endcode
+ *
+ * @tparam M  a @ref Model
+ *
+ * @param data  the data of which to compute the CRC
+ * @return      the CRC of @p data
+ */
+template <class M, class... Args>
+constexpr typename M::crc_type compute(const Args &...data) {
+  auto crc = M::crc();
+  crc.update(data...);
+  return crc.fini();
+}
+
+/// Some common models from the catalogue, named after their catalogue entry
+namespace models {
+/// CRC-8/SMBUS
+using crc8_smbus = Model<uint8_t, 8, 0x07, 0x00, 0x00, false, false>;
+/// CRC-16/XMODEM, also known as CRC-16/CCITT with a zero initial value
+using crc16_xmodem = Model<uint16_t, 16, 0x1021, 0x0000, 0x0000, false, false>;
+/// CRC-16/KERMIT
+using crc16_kermit = Model<uint16_t, 16, 0x1021, 0x0000, 0x0000, true, true>;
+/// CRC-16/IBM-SDLC, as used by HDLC and X.25
+using crc16_ibm_sdlc =
+    Model<uint16_t, 16, 0x1021, 0xffff, 0xffff, true, true>;
+/// CRC-24/BLE
+using crc24_ble = Model<uint32_t, 24, 0x00065b, 0x555555, 0x000000, true, true>;
+/// CRC-32/ISO-HDLC, as used by Ethernet, gzip and PNG
+using crc32_iso_hdlc =
+    Model<uint32_t, 32, 0x04c11db7, 0xffffffff, 0xffffffff, true, true>;
+/// CRC-32/CKSUM, as used by POSIX cksum
+using crc32_cksum =
+    Model<uint32_t, 32, 0x04c11db7, 0x00000000, 0xffffffff, false, false>;
+/// CRC-32/ISCSI, also known as CRC-32C
+using crc32_iscsi =
+    Model<uint32_t, 32, 0x1edc6f41, 0xffffffff, 0xffffffff, true, true>;
+/// CRC-64/ECMA-182
+using crc64_ecma_182 =
+    Model<uint64_t, 64, 0x42f0e1eba9ea3693, 0, 0, false, false>;
+/// CRC-64/XZ
+using crc64_xz = Model<uint64_t, 64, 0x42f0e1eba9ea3693, ~uint64_t(0),
+                       ~uint64_t(0), true, true>;
+} /* namespace models */
+
 } /* namespace crc3x */
 
 #endif /* CRC3X_H_ */
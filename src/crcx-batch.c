@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Batches of independent messages
+ *
+ * A table-driven CRC spends most of its time waiting for the previous lookup,
+ * because each lookup depends on the one before. Short messages are therefore
+ * processed CRCX_LANES at a time, one byte of each per step. Whenever a
+ * message ends, the next message of the batch takes over its lane, so that
+ * messages of different lengths keep all lanes busy.
+ */
+
+#include <stdint.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+struct crcx_lane {
+  struct crcx_stream *stream;
+  size_t len;
+};
+
+// only messages that the bound kernel would process a byte at a time benefit
+// from lanes. Slicing-by-N already overlaps its lookups, and folding with
+// crcx_clmul() is faster still.
+static bool crcx_batch_lanes(const struct crcx_msg *msg) {
+  switch (msg->stream->ctx->kernel) {
+  case CRCX_KERNEL_TABLE:
+    return true;
+  case CRCX_KERNEL_CLMUL:
+    return msg->len < CRCX_CLMUL_MIN;
+  default:
+    return false;
+  }
+}
+
+static void crcx_batch_one(struct crcx_stream *stream, const uint8_t *data,
+                           size_t len) {
+  stream->lfsr = stream->ctx->update(stream->ctx, stream->lfsr, data, len);
+}
+
+bool crcx_batch(struct crcx_msg *msgs, size_t count, uintmax_t *crcs) {
+  struct crcx_lane lane[CRCX_LANES];
+  const uint8_t *data[CRCX_LANES];
+  uintmax_t lfsr[CRCX_LANES];
+  const struct crcx_ctx *ctx = NULL;
+  uint8_t used = 0;
+
+  if (NULL == msgs && 0 != count) {
+    return false;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (!crcx_stream_valid(msgs[i].stream) ||
+        NULL == msgs[i].stream->ctx->update ||
+        (NULL == msgs[i].data && 0 != msgs[i].len)) {
+      D("invalid message %zu", i);
+      return false;
+    }
+  }
+
+  for (size_t i = 0;;) {
+    // fill the lanes with messages of the same context
+    for (; used < CRCX_LANES && i < count; ++i) {
+      struct crcx_msg *msg = &msgs[i];
+      if (!crcx_batch_lanes(msg)) {
+        crcx_batch_one(msg->stream, msg->data, msg->len);
+        continue;
+      }
+      if (0 != used && msg->stream->ctx != ctx) {
+        break;
+      }
+      ctx = msg->stream->ctx;
+      lane[used].stream = msg->stream;
+      lane[used].len = msg->len;
+      data[used] = msg->data;
+      lfsr[used] = msg->stream->lfsr;
+      ++used;
+    }
+
+    if (used < CRCX_LANES) {
+      // the context changes or the batch ends
+      for (uint8_t j = 0; j < used; ++j) {
+        lane[j].stream->lfsr = lfsr[j];
+        crcx_batch_one(lane[j].stream, data[j], lane[j].len);
+      }
+      used = 0;
+      if (i == count) {
+        break;
+      }
+      continue;
+    }
+
+    // run the lanes until the shortest message ends
+    size_t len = lane[0].len;
+    for (uint8_t j = 1; j < CRCX_LANES; ++j) {
+      len = MIN(len, lane[j].len);
+    }
+
+    crcx_lanes_kernel(ctx)(ctx, lfsr, data, len);
+
+    for (uint8_t j = 0; j < used;) {
+      lane[j].len -= len;
+      if (0 != lane[j].len) {
+        ++j;
+        continue;
+      }
+      lane[j].stream->lfsr = lfsr[j];
+      --used;
+      lane[j] = lane[used];
+      data[j] = data[used];
+      lfsr[j] = lfsr[used];
+    }
+  }
+
+  if (NULL != crcs) {
+    for (size_t i = 0; i < count; ++i) {
+      crcs[i] = crcx_stream_fini(msgs[i].stream);
+    }
+  }
+
+  return true;
+}
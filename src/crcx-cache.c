@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Process-wide cache of the data derived from CRC parameters
+ *
+ * The table, the folding constants and the zero-extension operators of a
+ * context only depend on n, the polynomial and whether the input is
+ * reflected. The first crcx_init() for such a combination computes them and
+ * publishes an immutable entry in a fixed-size, open-addressed hash table.
+ * Later calls copy the entry instead.
+ *
+ * Slots are only ever filled with compare-and-swap and entries are never
+ * freed, so lookups do not take locks. If two threads miss at the same time,
+ * both compute the entry and the one that loses the race discards its own.
+ * When the cache is full, further combinations are computed every time.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+// the maximum number of cached parameter combinations
+#define CRCX_CACHE_SIZE 64
+
+#if !defined(__STDC_NO_ATOMICS__)
+
+#include <stdatomic.h>
+
+struct crcx_cache_entry {
+  uint8_t n;
+  bool reflect_input;
+  uintmax_t poly;
+  uint64_t table[256];
+  uint64_t fold[10];
+  uintmax_t zeros[64];
+};
+
+static _Atomic(struct crcx_cache_entry *) crcx_cache[CRCX_CACHE_SIZE];
+static atomic_size_t crcx_cache_entries;
+static atomic_uint_fast64_t crcx_cache_hits;
+static atomic_uint_fast64_t crcx_cache_misses;
+
+static size_t crcx_cache_hash(uint8_t n, uintmax_t poly, bool reflect_input) {
+  uint64_t h = (uint64_t)poly * 0x9e3779b97f4a7c15ULL;
+  h ^= ((uint64_t)n << 1 | reflect_input) * 0xff51afd7ed558ccdULL;
+  return (size_t)(h >> 32) % CRCX_CACHE_SIZE;
+}
+
+static bool crcx_cache_match(const struct crcx_cache_entry *e, uint8_t n,
+                             uintmax_t poly, bool reflect_input) {
+  return e->n == n && e->poly == poly && e->reflect_input == reflect_input;
+}
+
+static void crcx_cache_copy(struct crcx_ctx *ctx,
+                            const struct crcx_cache_entry *e) {
+  const uint8_t w = crcx_width(ctx->n);
+
+  memcpy((uint64_t *)ctx->table64, e->table, 256 * (w / 8));
+  memcpy((uint64_t *)ctx->fold, e->fold, sizeof(ctx->fold));
+  memcpy((uintmax_t *)ctx->zeros, e->zeros, sizeof(ctx->zeros));
+}
+
+void crcx_cache_load(struct crcx_ctx *ctx) {
+  const uint8_t n = ctx->n;
+  const uintmax_t poly = ctx->poly & ctx->mask;
+  const bool reflect_input = ctx->reflect_input;
+  const size_t h = crcx_cache_hash(n, poly, reflect_input);
+  struct crcx_cache_entry *e;
+  size_t i;
+
+  for (i = 0; i < CRCX_CACHE_SIZE; ++i) {
+    e = atomic_load_explicit(&crcx_cache[(h + i) % CRCX_CACHE_SIZE],
+                             memory_order_acquire);
+    if (NULL == e) {
+      break;
+    }
+    if (crcx_cache_match(e, n, poly, reflect_input)) {
+      atomic_fetch_add_explicit(&crcx_cache_hits, 1, memory_order_relaxed);
+      crcx_cache_copy(ctx, e);
+      return;
+    }
+  }
+
+  atomic_fetch_add_explicit(&crcx_cache_misses, 1, memory_order_relaxed);
+  crcx_derive(ctx);
+
+  if (CRCX_CACHE_SIZE == i) {
+    D("cache full");
+    return;
+  }
+
+  struct crcx_cache_entry *entry = malloc(sizeof(*entry));
+  if (NULL == entry) {
+    return;
+  }
+
+  entry->n = n;
+  entry->poly = poly;
+  entry->reflect_input = reflect_input;
+  memcpy(entry->table, ctx->table64, sizeof(entry->table));
+  memcpy(entry->fold, ctx->fold, sizeof(entry->fold));
+  memcpy(entry->zeros, ctx->zeros, sizeof(entry->zeros));
+
+  for (; i < CRCX_CACHE_SIZE; ++i) {
+    _Atomic(struct crcx_cache_entry *) *slot =
+        &crcx_cache[(h + i) % CRCX_CACHE_SIZE];
+    e = NULL;
+    if (atomic_compare_exchange_strong_explicit(
+            slot, &e, entry, memory_order_release, memory_order_acquire)) {
+      atomic_fetch_add_explicit(&crcx_cache_entries, 1, memory_order_relaxed);
+      return;
+    }
+    if (crcx_cache_match(e, n, poly, reflect_input)) {
+      // another thread published the same entry first
+      break;
+    }
+  }
+
+  free(entry);
+}
+
+void crcx_get_cache_stats(struct crcx_cache_stats *stats) {
+  if (NULL == stats) {
+    return;
+  }
+
+  stats->hits = atomic_load_explicit(&crcx_cache_hits, memory_order_relaxed);
+  stats->misses =
+      atomic_load_explicit(&crcx_cache_misses, memory_order_relaxed);
+  stats->entries =
+      atomic_load_explicit(&crcx_cache_entries, memory_order_relaxed);
+  stats->capacity = CRCX_CACHE_SIZE;
+}
+
+#else
+
+void crcx_cache_load(struct crcx_ctx *ctx) { crcx_derive(ctx); }
+
+void crcx_get_cache_stats(struct crcx_cache_stats *stats) {
+  if (NULL != stats) {
+    memset(stats, 0, sizeof(*stats));
+  }
+}
+
+#endif
@@ -0,0 +1,414 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * crcx - compute CRCs of files
+ *
+ * The default output is that of crc32(1), i.e. the CRC-32/ISO-HDLC of each
+ * file in hexadecimal. With --cksum, the output is that of cksum(1), i.e. the
+ * POSIX CRC of each file followed by its length.
+ */
+
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "crcx/crcx.h"
+
+// the size of the buffer used for input that cannot be mapped
+#define CRCX_CLI_BLOCK (1 << 20)
+
+// the default size of the buffer used with --bench
+#define CRCX_CLI_BENCH (256 << 20)
+
+enum crcx_cli_format {
+  CRCX_CLI_CRC32, // crc32(1)
+  CRCX_CLI_CKSUM, // cksum(1)
+};
+
+struct crcx_cli {
+  struct crcx_ctx ctx;
+  enum crcx_cli_format format;
+  unsigned threads;
+  bool multiple;
+};
+
+static const char *crcx_cli_name = "crcx";
+
+static void crcx_cli_usage(FILE *fp) {
+  fprintf(fp,
+          "Usage: %s [OPTION]... [FILE]...\n"
+          "Compute the CRC of each FILE, or of standard input.\n"
+          "\n"
+          "  -m, --model=NAME     use the catalogue model NAME "
+          "(default: CRC-32/ISO-HDLC)\n"
+          "  -c, --custom=N,POLY,INIT,XOROUT,REFIN,REFOUT\n"
+          "                       use a custom model, e.g. "
+          "32,0x04c11db7,-1,-1,1,1\n"
+          "      --cksum          print the POSIX CRC and length of each FILE,"
+          " like cksum\n"
+          "                       (not with --model or --custom)\n"
+          "  -j, --threads=N      use up to N threads per file "
+          "(default: one per CPU)\n"
+          "  -l, --list           list the catalogue of models\n"
+          "  -b, --bench[=SIZE]   measure the throughput of each kernel over "
+          "SIZE bytes\n"
+          "  -h, --help           display this help and exit\n",
+          crcx_cli_name);
+}
+
+static bool crcx_cli_error(const char *what) {
+  fprintf(stderr, "%s: %s: %s\n", crcx_cli_name, what, strerror(errno));
+  return false;
+}
+
+static bool crcx_cli_parse(const char *s, uintmax_t *value) {
+  char *end;
+
+  errno = 0;
+  if ('-' == s[0]) {
+    *value = (uintmax_t)strtoimax(s, &end, 0);
+  } else {
+    *value = strtoumax(s, &end, 0);
+  }
+
+  return 0 == errno && end != s && '\0' == *end;
+}
+
+// N,POLY,INIT,XOROUT,REFIN,REFOUT
+static bool crcx_cli_custom(struct crcx_ctx *ctx, const char *spec) {
+  uintmax_t v[6];
+  char buf[256];
+  char *save = NULL;
+  size_t i = 0;
+
+  snprintf(buf, sizeof(buf), "%s", spec);
+  for (char *tok = strtok_r(buf, ",", &save); NULL != tok;
+       tok = strtok_r(NULL, ",", &save)) {
+    if (i == 6 || !crcx_cli_parse(tok, &v[i++])) {
+      return false;
+    }
+  }
+
+  return 6 == i && v[0] <= 64 &&
+         crcx_init(ctx, (uint8_t)v[0], v[1], v[2], v[3], 0 != v[4],
+                   0 != v[5]);
+}
+
+static void crcx_cli_list(void) {
+  size_t count;
+  const struct crcx_model *m = crcx_models(&count);
+
+  for (size_t i = 0; i < count; ++i) {
+    printf("%-24s width=%-2u poly=0x%0*jx init=0x%0*jx refin=%s refout=%s "
+           "xorout=0x%0*jx check=0x%0*jx\n",
+           m[i].name, m[i].n, (m[i].n + 3) / 4, m[i].poly, (m[i].n + 3) / 4,
+           m[i].init, m[i].reflect_input ? "true" : "false",
+           m[i].reflect_output ? "true" : "false", (m[i].n + 3) / 4,
+           m[i].fini, (m[i].n + 3) / 4, m[i].check);
+  }
+}
+
+// read fd until the end of the file
+static bool crcx_cli_read(struct crcx_cli *cli, int fd, uintmax_t *len) {
+  static uint8_t buf[CRCX_CLI_BLOCK];
+
+  for (;;) {
+    ssize_t r = read(fd, buf, sizeof(buf));
+    if (r < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+    if (0 == r) {
+      return true;
+    }
+    crcx(&cli->ctx, buf, (size_t)r);
+    *len += (uintmax_t)r;
+  }
+}
+
+// compute the CRC of fd from its current offset, like read() would, splitting
+// regular files among threads
+static bool crcx_cli_fd(struct crcx_cli *cli, int fd, uintmax_t *len) {
+  struct stat st;
+
+  *len = 0;
+
+  if (-1 == fstat(fd, &st)) {
+    return false;
+  }
+
+  // e.g. stdin redirected from a file that was partially read already
+  const off_t offset = lseek(fd, 0, SEEK_CUR);
+  if (!S_ISREG(st.st_mode) || -1 == offset || offset >= st.st_size) {
+    return crcx_cli_read(cli, fd, len);
+  }
+
+  // mmap() needs an offset that is a multiple of the page size
+  const off_t skip = offset % (off_t)sysconf(_SC_PAGESIZE);
+  const size_t size = (size_t)(st.st_size - offset + skip);
+  void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, offset - skip);
+  if (MAP_FAILED == map && 0 != offset) {
+    return crcx_cli_read(cli, fd, len);
+  }
+
+  *len = (uintmax_t)(st.st_size - offset);
+
+  if (MAP_FAILED == map) {
+    return crcx_fd(&cli->ctx, fd);
+  }
+
+  (void)madvise(map, size, MADV_SEQUENTIAL);
+  bool ok =
+      crcx_parallel(&cli->ctx, (uint8_t *)map + skip, size - (size_t)skip,
+                    cli->threads);
+  munmap(map, size);
+
+  // leave the offset at the end, as reading would have
+  (void)lseek(fd, st.st_size, SEEK_SET);
+
+  return ok;
+}
+
+// the length of the input follows it, least-significant byte first
+static void crcx_cli_cksum(struct crcx_cli *cli, uintmax_t len) {
+  for (; 0 != len; len >>= 8) {
+    const uint8_t byte = (uint8_t)len;
+    crcx(&cli->ctx, &byte, 1);
+  }
+}
+
+static bool crcx_cli_file(struct crcx_cli *cli, const char *path) {
+  const bool stdio = 0 == strcmp("-", path);
+  uintmax_t len;
+
+  int fd = stdio ? STDIN_FILENO : open(path, O_RDONLY);
+  if (-1 == fd) {
+    return crcx_cli_error(path);
+  }
+
+  bool ok = crcx_cli_fd(cli, fd, &len);
+  if (!stdio) {
+    close(fd);
+  }
+  if (!ok) {
+    crcx_fini(&cli->ctx);
+    return crcx_cli_error(path);
+  }
+
+  if (CRCX_CLI_CKSUM == cli->format) {
+    crcx_cli_cksum(cli, len);
+    printf("%ju %ju", crcx_fini(&cli->ctx), len);
+    if (!stdio) {
+      printf(" %s", path);
+    }
+  } else {
+    printf("%0*jx", (cli->ctx.n + 3) / 4, crcx_fini(&cli->ctx));
+    if (cli->multiple) {
+      printf("\t%s", path);
+    }
+  }
+  printf("\n");
+
+  return true;
+}
+
+static double crcx_cli_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static void crcx_cli_bench1(struct crcx_cli *cli, const char *name,
+                            const uint8_t *buf, size_t len, unsigned threads) {
+  double best = 0;
+
+  // the best of a few runs, after warming up the tables and the buffer
+  for (int i = 0; i < 4; ++i) {
+    const double start = crcx_cli_now();
+    crcx_parallel(&cli->ctx, buf, len, threads);
+    const double t = crcx_cli_now() - start;
+    crcx_fini(&cli->ctx);
+    if (0 != i && (0 == best || t < best)) {
+      best = t;
+    }
+  }
+
+  printf("%-8s %3u %8.2f GB/s\n", name, threads, (double)len / best / 1e9);
+}
+
+static bool crcx_cli_bench(struct crcx_cli *cli, size_t len) {
+  static uintmax_t slices[CRCX_SLICES_MAX][256];
+  const enum crcx_kernel kernels[] = {
+      CRCX_KERNEL_TABLE,
+      CRCX_KERNEL_SLICING,
+      CRCX_KERNEL_CLMUL,
+      CRCX_KERNEL_CRC32C,
+  };
+  const enum crcx_kernel fastest = crcx_get_kernel(&cli->ctx);
+
+  uint8_t *buf = (uint8_t *)malloc(len);
+  if (NULL == buf) {
+    return crcx_cli_error("bench");
+  }
+  for (size_t i = 0; i < len; ++i) {
+    buf[i] = (uint8_t)(i * 2654435761u >> 24);
+  }
+
+  printf("%-8s %3s %13s\n", "kernel", "thr", "throughput");
+  for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); ++i) {
+    if (CRCX_KERNEL_SLICING == kernels[i]) {
+      crcx_set_kernel(&cli->ctx, CRCX_KERNEL_TABLE);
+      crcx_generate_slices(&cli->ctx, slices, sizeof(slices), CRCX_SLICES_MAX);
+    } else if (!crcx_set_kernel(&cli->ctx, kernels[i])) {
+      continue;
+    }
+    crcx_cli_bench1(cli, crcx_kernel_name(kernels[i]), buf, len, 1);
+  }
+
+  const unsigned threads = 0 != cli->threads
+                              ? cli->threads
+                              : (unsigned)sysconf(_SC_NPROCESSORS_ONLN);
+  crcx_set_kernel(&cli->ctx, fastest);
+  if (threads > 1) {
+    crcx_cli_bench1(cli, crcx_kernel_name(fastest), buf, len, threads);
+  }
+
+  free(buf);
+
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  static const struct option options[] = {
+      {"model", required_argument, NULL, 'm'},
+      {"custom", required_argument, NULL, 'c'},
+      {"cksum", no_argument, NULL, 'C'},
+      {"threads", required_argument, NULL, 'j'},
+      {"list", no_argument, NULL, 'l'},
+      {"bench", optional_argument, NULL, 'b'},
+      {"help", no_argument, NULL, 'h'},
+      {NULL, 0, NULL, 0},
+  };
+  struct crcx_cli cli = {.format = CRCX_CLI_CRC32, .threads = 0};
+  const char *model = NULL;
+  const char *custom = NULL;
+  size_t bench = 0;
+  uintmax_t v;
+  int c;
+
+  crcx_cli_name = argv[0];
+
+  while (-1 != (c = getopt_long(argc, argv, "m:c:j:lb::h", options, NULL))) {
+    switch (c) {
+    case 'm':
+      model = optarg;
+      break;
+    case 'c':
+      custom = optarg;
+      break;
+    case 'C':
+      cli.format = CRCX_CLI_CKSUM;
+      break;
+    case 'j':
+      if (!crcx_cli_parse(optarg, &v) || v > UINT_MAX) {
+        fprintf(stderr, "%s: invalid number of threads: %s\n", argv[0],
+                optarg);
+        return EXIT_FAILURE;
+      }
+      cli.threads = (unsigned)v;
+      break;
+    case 'l':
+      crcx_cli_list();
+      return EXIT_SUCCESS;
+    case 'b':
+      bench = CRCX_CLI_BENCH;
+      if (NULL != optarg && (!crcx_cli_parse(optarg, &v) || 0 == v)) {
+        fprintf(stderr, "%s: invalid size: %s\n", argv[0], optarg);
+        return EXIT_FAILURE;
+      }
+      bench = NULL != optarg ? (size_t)v : bench;
+      break;
+    case 'h':
+      crcx_cli_usage(stdout);
+      return EXIT_SUCCESS;
+    default:
+      crcx_cli_usage(stderr);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // cksum(1) output only makes sense for its CRC, whatever the order of options
+  if (CRCX_CLI_CKSUM == cli.format) {
+    if (NULL != model || NULL != custom) {
+      fprintf(stderr, "%s: --cksum cannot be used with --model or --custom\n",
+              argv[0]);
+      crcx_cli_usage(stderr);
+      return EXIT_FAILURE;
+    }
+    model = "CRC-32/CKSUM";
+  } else if (NULL == model) {
+    model = "CRC-32/ISO-HDLC";
+  }
+
+  if (NULL != custom ? !crcx_cli_custom(&cli.ctx, custom)
+                     : !crcx_init_model(&cli.ctx, model)) {
+    fprintf(stderr, "%s: invalid model: %s\n", argv[0],
+            NULL != custom ? custom : model);
+    return EXIT_FAILURE;
+  }
+
+  if (0 != bench) {
+    return crcx_cli_bench(&cli, bench) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (optind == argc) {
+    return crcx_cli_file(&cli, "-") ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  bool ok = true;
+  cli.multiple = argc - optind > 1;
+  for (int i = optind; i < argc; ++i) {
+    ok &= crcx_cli_file(&cli, argv[i]);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,244 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * CRC folding with carry-less multiplication
+ *
+ * Every CRC of n <= 64 bits is computed as a CRC over the 64-bit polynomial
+ * Q(x) = P(x) * x^(64 - n), whose register is the n-bit register shifted left
+ * by 64 - n bits. In the reflected bit order the register value is the same
+ * for both. This allows a single set of 64x64-bit multiplications to handle
+ * any polynomial accepted by crcx_init().
+ *
+ * The input is folded 16 bytes at a time by multiplying each 64-bit half of
+ * the accumulator by x^D mod Q(x) for the appropriate distance D, and the
+ * final 128-bit accumulator is reduced to 64 bits with Barrett reduction.
+ *
+ * For reflected input (LSB-first) the data is loaded as-is and the constants
+ * are bit-reversed. Since the product of two bit-reversed 64-bit values is
+ * the bit-reversed product multiplied by x, those constants use D - 1.
+ *
+ * @see <a
+ * href="https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/fast-crc-computation-generic-polynomials-pclmulqdq-paper.pdf">Fast
+ * CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction</a>
+ */
+
+#include <stdint.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CRCX_HAVE_CLMUL 1
+#include <immintrin.h>
+#endif
+
+enum {
+  // indices into crcx_ctx.fold
+  FOLD_512 = 0, // 2 constants: fold 64 bytes ahead (lane 0, lane 1)
+  FOLD_128 = 2, // 2 constants: fold 16 bytes ahead (lane 0, lane 1)
+  FOLD_MU = 4,  // floor(x^128 / Q(x)) without the x^64 term
+  FOLD_Q = 5,   // Q(x) without the x^64 term
+};
+
+// x^e mod Q(x)
+static uint64_t xpow(unsigned e, uint64_t q) {
+  uint64_t r = 1;
+  for (unsigned i = 0; i < e; ++i) {
+    r = (r << 1) ^ ((r >> 63) ? q : 0);
+  }
+  return r;
+}
+
+// floor(x^128 / Q(x)) without the x^64 term
+static uint64_t barrett(uint64_t q) {
+  // after subtracting Q(x) * x^64 from x^128, only bits 64..127 matter
+  uint64_t hi = q;
+  uint64_t mu = 0;
+  for (int s = 63; s >= 0; --s) {
+    if ((hi >> s) & 1) {
+      mu |= (uint64_t)1 << s;
+      hi ^= (uint64_t)1 << s;
+      if (s > 0) {
+        hi ^= q >> (64 - s);
+      }
+    }
+  }
+  return mu;
+}
+
+static uint64_t rev64(uint64_t x) { return crcx_reflect(x, 64); }
+
+void crcx_clmul_init(struct crcx_ctx *ctx) {
+  uint64_t *fold = (uint64_t *)ctx->fold;
+  const uint8_t k = 64 - ctx->n;
+  const uint64_t q = (uint64_t)(ctx->poly & ctx->mask) << k;
+
+  if (ctx->reflect_input) {
+    // lane 0 holds the high-order half of the accumulator
+    fold[FOLD_512 + 0] = rev64(xpow(512 + 64 - 1, q));
+    fold[FOLD_512 + 1] = rev64(xpow(512 - 1, q));
+    fold[FOLD_128 + 0] = rev64(xpow(128 + 64 - 1, q));
+    fold[FOLD_128 + 1] = rev64(xpow(128 - 1, q));
+    fold[FOLD_MU] = rev64(barrett(q));
+    fold[FOLD_Q] = rev64(q);
+  } else {
+    // lane 1 holds the high-order half of the accumulator
+    fold[FOLD_512 + 0] = xpow(512, q);
+    fold[FOLD_512 + 1] = xpow(512 + 64, q);
+    fold[FOLD_128 + 0] = xpow(128, q);
+    fold[FOLD_128 + 1] = xpow(128 + 64, q);
+    fold[FOLD_MU] = barrett(q);
+    fold[FOLD_Q] = q;
+  }
+}
+
+#if defined(CRCX_HAVE_CLMUL)
+
+#define CLMUL_TARGET __attribute__((target("pclmul,ssse3,sse4.1")))
+#define CLMUL_INLINE static inline __attribute__((always_inline)) CLMUL_TARGET
+
+CLMUL_INLINE __m128i load(const uint8_t *data, const bool reflected) {
+  __m128i x = _mm_loadu_si128((const __m128i *)data);
+  if (!reflected) {
+    // the first byte of the block holds the highest-order coefficients
+    const __m128i bswap =
+        _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    x = _mm_shuffle_epi8(x, bswap);
+  }
+  return x;
+}
+
+CLMUL_INLINE __m128i clmul64(uint64_t a, uint64_t b) {
+  return _mm_clmulepi64_si128(_mm_cvtsi64_si128((int64_t)a),
+                              _mm_cvtsi64_si128((int64_t)b), 0x00);
+}
+
+CLMUL_INLINE __m128i fold(__m128i x, __m128i k) {
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                       _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+CLMUL_INLINE uintmax_t crcx_clmul_impl(const struct crcx_ctx *ctx,
+                                       uintmax_t lfsr, const uint8_t *data,
+                                       size_t len, const bool reflected) {
+
+  const uint8_t k = 64 - ctx->n;
+  const __m128i k512 = _mm_loadu_si128((const __m128i *)&ctx->fold[FOLD_512]);
+  const __m128i k128 = _mm_loadu_si128((const __m128i *)&ctx->fold[FOLD_128]);
+  __m128i x;
+
+  // xor the lfsr into the high-order 64 bits of the first block. The
+  // reflected lfsr is already the reflected register of Q(x).
+  uint64_t r = (uint64_t)lfsr;
+  const __m128i init = reflected ? _mm_cvtsi64_si128((int64_t)r)
+                                 : _mm_set_epi64x((int64_t)(r << k), 0);
+
+  if (len >= 128) {
+    __m128i x0 = _mm_xor_si128(load(data + 0, reflected), init);
+    __m128i x1 = load(data + 16, reflected);
+    __m128i x2 = load(data + 32, reflected);
+    __m128i x3 = load(data + 48, reflected);
+    data += 64;
+    len -= 64;
+
+    // four independent accumulators hide the latency of pclmulqdq
+    for (; len >= 64; data += 64, len -= 64) {
+      x0 = _mm_xor_si128(fold(x0, k512), load(data + 0, reflected));
+      x1 = _mm_xor_si128(fold(x1, k512), load(data + 16, reflected));
+      x2 = _mm_xor_si128(fold(x2, k512), load(data + 32, reflected));
+      x3 = _mm_xor_si128(fold(x3, k512), load(data + 48, reflected));
+    }
+
+    x = _mm_xor_si128(fold(x0, k128), x1);
+    x = _mm_xor_si128(fold(x, k128), x2);
+    x = _mm_xor_si128(fold(x, k128), x3);
+  } else {
+    x = _mm_xor_si128(load(data, reflected), init);
+    data += 16;
+    len -= 16;
+  }
+
+  for (; len >= 16; data += 16, len -= 16) {
+    x = _mm_xor_si128(fold(x, k128), load(data, reflected));
+  }
+
+  // Multiply the 128-bit accumulator by x^64 and reduce it modulo Q(x)
+  const uint64_t mu = ctx->fold[FOLD_MU];
+  const uint64_t q = ctx->fold[FOLD_Q];
+  uint64_t hi, lo, t;
+  __m128i p;
+
+  if (reflected) {
+    p = _mm_clmulepi64_si128(x, _mm_cvtsi64_si128(ctx->fold[FOLD_128 + 1]),
+                             0x00);
+    hi = (uint64_t)_mm_cvtsi128_si64(p) ^ (uint64_t)_mm_extract_epi64(x, 1);
+    lo = (uint64_t)_mm_extract_epi64(p, 1);
+
+    p = clmul64(hi, mu);
+    t = hi ^ ((uint64_t)_mm_cvtsi128_si64(p) << 1);
+
+    p = clmul64(t, q);
+    r = lo ^ ((uint64_t)_mm_extract_epi64(p, 1) << 1) ^
+        ((uint64_t)_mm_cvtsi128_si64(p) >> 63);
+  } else {
+    p = _mm_clmulepi64_si128(x, _mm_cvtsi64_si128(ctx->fold[FOLD_128 + 0]),
+                             0x01);
+    hi = (uint64_t)_mm_extract_epi64(p, 1) ^ (uint64_t)_mm_cvtsi128_si64(x);
+    lo = (uint64_t)_mm_cvtsi128_si64(p);
+
+    p = clmul64(hi, mu);
+    t = hi ^ (uint64_t)_mm_extract_epi64(p, 1);
+
+    p = clmul64(t, q);
+    r = lo ^ (uint64_t)_mm_cvtsi128_si64(p);
+  }
+
+  // the reflected register of Q(x) is the reflected n-bit register
+  return reflected ? r : r >> k;
+}
+
+CLMUL_TARGET uintmax_t crcx_clmul(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                                  const uint8_t *data, size_t len) {
+  if (len >= CRCX_CLMUL_MIN) {
+    const size_t n = len & ~(size_t)15;
+    if (ctx->reflect_input) {
+      lfsr = crcx_clmul_impl(ctx, lfsr, data, n, true);
+    } else {
+      lfsr = crcx_clmul_impl(ctx, lfsr, data, n, false);
+    }
+    data += n;
+    len -= n;
+  }
+  return crcx_slicing(ctx, lfsr, data, len);
+}
+
+#else
+
+uintmax_t crcx_clmul(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                     const uint8_t *data, size_t len) {
+  return crcx_slicing(ctx, lfsr, data, len);
+}
+
+#endif /* defined(CRCX_HAVE_CLMUL) */
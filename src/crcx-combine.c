@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Polynomial arithmetic modulo the CRC polynomial
+ *
+ * All values are n-bit polynomials in the bit order of the lfsr of a context,
+ * i.e. reflected when @ref crcx_ctx.reflect_input is set. Appending len zero
+ * bytes to a message multiplies its lfsr by x^(8 * len) mod P(x), which is
+ * the product of the operators x^(8 * 2^k) mod P(x) for the bits k set in len.
+ * Those are computed once by squaring, so this takes O(log len)
+ * multiplications.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+// multiply a by x modulo P(x)
+static inline uintmax_t crcx_mulx(const struct crcx_ctx *ctx, uintmax_t poly,
+                                  uintmax_t a) {
+  if (ctx->reflect_input) {
+    return (a & 1) ? (a >> 1) ^ poly : a >> 1;
+  }
+
+  return (a & ctx->msb) ? ((a << 1) ^ poly) & ctx->mask : a << 1;
+}
+
+uintmax_t crcx_mulmod(const struct crcx_ctx *ctx, uintmax_t a, uintmax_t b) {
+  const uintmax_t poly = ctx->reflect_input
+                             ? crcx_reflect(ctx->poly & ctx->mask, ctx->n)
+                             : ctx->poly & ctx->mask;
+  uintmax_t r = 0;
+
+  // Horner's method, from the coefficient of x^(n - 1) down to x^0
+  for (uint8_t i = 0; i < ctx->n; ++i) {
+    r = crcx_mulx(ctx, poly, r);
+    const uint8_t bit = ctx->reflect_input ? i : ctx->n - 1 - i;
+    if ((a >> bit) & 1) {
+      r ^= b;
+    }
+  }
+
+  return r;
+}
+
+void crcx_zeros_init(struct crcx_ctx *ctx) {
+  uintmax_t *zeros = (uintmax_t *)ctx->zeros;
+  const uintmax_t poly = ctx->reflect_input
+                             ? crcx_reflect(ctx->poly & ctx->mask, ctx->n)
+                             : ctx->poly & ctx->mask;
+
+  // x^8 mod P(x), the operator that appends one zero byte
+  uintmax_t sq = ctx->reflect_input ? ctx->msb : 1;
+  for (uint8_t i = 0; i < 8; ++i) {
+    sq = crcx_mulx(ctx, poly, sq);
+  }
+
+  for (size_t k = 0; k < ARRAY_SIZE(ctx->zeros); ++k) {
+    zeros[k] = sq;
+    sq = crcx_mulmod(ctx, sq, sq);
+  }
+}
+
+uintmax_t crcx_shift(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                     uintmax_t len) {
+  for (size_t k = 0; len > 0; ++k, len >>= 1) {
+    if (len & 1) {
+      lfsr = crcx_mulmod(ctx, lfsr, ctx->zeros[k]);
+    }
+  }
+
+  return lfsr;
+}
+
+bool crcx_zeros(struct crcx_ctx *ctx, uintmax_t len) {
+
+  if (NULL == ctx || NULL == ctx->update) {
+    return false;
+  }
+
+  ctx->lfsr = crcx_shift(ctx, ctx->lfsr, len);
+
+  return true;
+}
+
+uintmax_t crcx_combine(const struct crcx_ctx *ctx, uintmax_t crc1,
+                       uintmax_t crc2, uintmax_t len2) {
+
+  if (NULL == ctx || NULL == ctx->update) {
+    return -1;
+  }
+
+  // Both lfsrs start with the initial value, which has to be removed from the
+  // first one before appending len2 zero bytes to it. What remains is the
+  // lfsr of the concatenation.
+  uintmax_t lfsr = crcx_lfsr_unfini(ctx, crc1 & ctx->mask);
+  lfsr ^= crcx_lfsr_init(ctx);
+  lfsr = crcx_shift(ctx, lfsr, len2);
+  lfsr ^= crcx_lfsr_unfini(ctx, crc2 & ctx->mask);
+
+  D("crc1: %" PRIxMAX " crc2: %" PRIxMAX " len2: %" PRIuMAX, crc1, crc2, len2);
+
+  return crcx_lfsr_fini(ctx, lfsr);
+}
@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * CRC-32C (Castagnoli) with the SSE4.2 crc32 instruction
+ *
+ * The crc32 instruction has a latency of 3 cycles but a throughput of one
+ * per cycle, so large inputs are split into three streams that are processed
+ * in an interleaved manner. The three partial CRCs are then combined by
+ * shifting the first two over the length of the data that follows them,
+ * which is done with one carry-less multiplication and one crc32 each.
+ *
+ * @see <a href="https://stackoverflow.com/a/17646775">Mark Adler's
+ * hardware-accelerated CRC-32C</a>
+ * @see <a
+ * href="https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/crc-iscsi-polynomial-crc32-instruction-paper.pdf">Fast
+ * CRC Computation for iSCSI Polynomial Using CRC32 Instruction</a>
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CRCX_HAVE_CRC32C 1
+#include <immintrin.h>
+#endif
+
+#define CRC32C_POLY 0x1EDC6F41
+
+enum {
+  // bytes per stream for each of the three interleaved streams
+  LONG = 8192,
+  SHORT = 256,
+  // indices into crcx_ctx.fold, after those used by crcx_clmul()
+  SHIFT_LONG2 = 6,
+  SHIFT_LONG = 7,
+  SHIFT_SHORT2 = 8,
+  SHIFT_SHORT = 9,
+};
+
+// a * b mod P(x)
+static uint32_t mulmod(uint32_t a, uint32_t b) {
+  uint32_t r = 0;
+  for (int i = 31; i >= 0; --i) {
+    r = (r << 1) ^ ((r >> 31) ? CRC32C_POLY : 0);
+    if ((b >> i) & 1) {
+      r ^= a;
+    }
+  }
+  return r;
+}
+
+// the bit-reversal of x^(8 * len - 33) mod P(x), for shifting by len bytes
+static uint64_t shift_constant(size_t len) {
+  uint32_t r = 1;
+  uint32_t x = 2;
+  for (size_t e = 8 * len - 33; e > 0; e >>= 1) {
+    if (e & 1) {
+      r = mulmod(r, x);
+    }
+    x = mulmod(x, x);
+  }
+  return crcx_reflect(r, 32);
+}
+
+bool crcx_crc32c_match(const struct crcx_ctx *ctx) {
+  return 32 == ctx->n && CRC32C_POLY == (ctx->poly & ctx->mask) &&
+         ctx->reflect_input;
+}
+
+bool crcx_crc32c_init(struct crcx_ctx *ctx) {
+  uint64_t *fold = (uint64_t *)ctx->fold;
+
+  if (!crcx_crc32c_match(ctx)) {
+    return false;
+  }
+
+  fold[SHIFT_LONG2] = shift_constant(2 * LONG);
+  fold[SHIFT_LONG] = shift_constant(LONG);
+  fold[SHIFT_SHORT2] = shift_constant(2 * SHORT);
+  fold[SHIFT_SHORT] = shift_constant(SHORT);
+
+  return true;
+}
+
+#if defined(CRCX_HAVE_CRC32C)
+
+#define CRC32C_TARGET __attribute__((target("sse4.2,pclmul")))
+#define CRC32C_INLINE                                                          \
+  static inline __attribute__((always_inline)) CRC32C_TARGET
+
+CRC32C_INLINE uint64_t load64(const uint8_t *data) {
+  uint64_t x;
+  memcpy(&x, data, sizeof(x));
+  return x;
+}
+
+// multiply crc by x^(8 * len) mod P(x) where k is the matching shift constant
+CRC32C_INLINE uint64_t shift(uint64_t crc, uint64_t k) {
+  __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128((int64_t)crc),
+                                   _mm_cvtsi64_si128((int64_t)k), 0x00);
+  return _mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(p));
+}
+
+CRC32C_INLINE uint64_t crc32c_3way(uint64_t crc0, const uint8_t **data,
+                                   size_t *len, const size_t block,
+                                   const uint64_t k2, const uint64_t k1) {
+  const uint8_t *p = *data;
+  size_t n = *len;
+
+  for (; n >= 3 * block; p += 3 * block, n -= 3 * block) {
+    uint64_t crc1 = 0;
+    uint64_t crc2 = 0;
+    for (size_t i = 0; i < block; i += 8) {
+      crc0 = _mm_crc32_u64(crc0, load64(p + i));
+      crc1 = _mm_crc32_u64(crc1, load64(p + block + i));
+      crc2 = _mm_crc32_u64(crc2, load64(p + 2 * block + i));
+    }
+    crc0 = shift(crc0, k2) ^ shift(crc1, k1) ^ crc2;
+  }
+
+  *data = p;
+  *len = n;
+
+  return crc0;
+}
+
+CRC32C_TARGET uintmax_t crcx_crc32c(const struct crcx_ctx *ctx,
+                                    uintmax_t lfsr, const uint8_t *data,
+                                    size_t len) {
+  // the crc32 instruction operates on the reflected register, like the lfsr
+  uint64_t crc = lfsr;
+
+  for (; len > 0 && 0 != ((uintptr_t)data & 7); ++data, --len) {
+    crc = _mm_crc32_u8((uint32_t)crc, *data);
+  }
+
+  if (ctx->clmul) {
+    crc = crc32c_3way(crc, &data, &len, LONG, ctx->fold[SHIFT_LONG2],
+                      ctx->fold[SHIFT_LONG]);
+    crc = crc32c_3way(crc, &data, &len, SHORT, ctx->fold[SHIFT_SHORT2],
+                      ctx->fold[SHIFT_SHORT]);
+  }
+
+  for (; len >= 8; data += 8, len -= 8) {
+    crc = _mm_crc32_u64(crc, load64(data));
+  }
+
+  for (; len > 0; ++data, --len) {
+    crc = _mm_crc32_u8((uint32_t)crc, *data);
+  }
+
+  return crc;
+}
+
+#else
+
+uintmax_t crcx_crc32c(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                      const uint8_t *data, size_t len) {
+  return crcx_slicing(ctx, lfsr, data, len);
+}
+
+#endif /* defined(CRCX_HAVE_CRC32C) */
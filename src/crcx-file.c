@@ -0,0 +1,254 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * CRC computation of files
+ *
+ * The data of regular files is mapped into memory CRCX_FILE_MAP bytes at a
+ * time, so that the kernel reads ahead and nothing is copied. If the file
+ * system reports holes with SEEK_DATA / SEEK_HOLE, only the data regions are
+ * mapped and every hole is accounted for with crcx_zeros().
+ *
+ * Files that cannot be mapped are read with pread() in blocks of
+ * CRCX_FILE_BLOCK bytes instead. Pipes, sockets, character devices and files
+ * whose size is not known in advance (e.g. in procfs) are read with read()
+ * until the end of the file.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // SEEK_DATA, SEEK_HOLE and MADV_HUGEPAGE
+#endif
+
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+#if !defined(_WIN32)
+#define CRCX_HAVE_PREAD 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// the size of the buffer used to read files
+#define CRCX_FILE_BLOCK (1 << 20)
+
+// the size of the part of a file that is mapped at a time
+#define CRCX_FILE_MAP (64 << 20)
+
+#if defined(CRCX_HAVE_PREAD)
+
+// process the bytes of fd in [*offset, end) through mappings of the file,
+// advancing *offset until the end or until the file cannot be mapped
+static void crcx_fd_map(struct crcx_ctx *ctx, int fd, off_t *offset,
+                        off_t end) {
+  const off_t page = (off_t)sysconf(_SC_PAGESIZE);
+
+  while (*offset < end) {
+    const off_t start = *offset & ~(page - 1);
+    const size_t len = (size_t)MIN((off_t)CRCX_FILE_MAP, end - start);
+    const size_t skip = (size_t)(*offset - start);
+
+    uint8_t *map = (uint8_t *)mmap(NULL, len, PROT_READ, MAP_SHARED, fd, start);
+    if (MAP_FAILED == map) {
+      D("mmap failed: %d", errno);
+      return;
+    }
+
+    // the hints are best-effort, e.g. huge pages require file system support
+    (void)madvise(map, len, MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+    (void)madvise(map, len, MADV_HUGEPAGE);
+#endif
+
+    crcx(ctx, map + skip, len - skip);
+    munmap(map, len);
+    *offset = start + (off_t)len;
+  }
+}
+
+// process the bytes of fd in [offset, end)
+static bool crcx_fd_data(struct crcx_ctx *ctx, int fd, uint8_t *buf,
+                         off_t offset, off_t end) {
+
+  while (offset < end) {
+    size_t len = (size_t)MIN((off_t)CRCX_FILE_BLOCK, end - offset);
+    ssize_t r = pread(fd, buf, len, offset);
+    if (r < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      D("pread failed: %d", errno);
+      return false;
+    }
+    if (0 == r) {
+      // the file was truncated
+      errno = EIO;
+      return false;
+    }
+    crcx(ctx, buf, (size_t)r);
+    offset += r;
+  }
+
+  return true;
+}
+
+// process the bytes of fd from its current offset until the end of the file
+static bool crcx_fd_stream(struct crcx_ctx *ctx, int fd, uint8_t *buf) {
+
+  for (;;) {
+    ssize_t r = read(fd, buf, CRCX_FILE_BLOCK);
+    if (r < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      D("read failed: %d", errno);
+      return false;
+    }
+    if (0 == r) {
+      return true;
+    }
+    crcx(ctx, buf, (size_t)r);
+  }
+}
+
+// a block-aligned buffer of CRCX_FILE_BLOCK bytes
+static uint8_t *crcx_fd_buf(void) {
+  void *buf = NULL;
+  int r = posix_memalign(&buf, (size_t)sysconf(_SC_PAGESIZE), CRCX_FILE_BLOCK);
+  if (0 != r) {
+    errno = r;
+    return NULL;
+  }
+  return (uint8_t *)buf;
+}
+
+bool crcx_fd(struct crcx_ctx *ctx, int fd) {
+  struct stat st;
+
+  if (NULL == ctx || NULL == ctx->update) {
+    errno = EINVAL;
+    return false;
+  }
+
+  if (-1 == fstat(fd, &st)) {
+    return false;
+  }
+
+  uint8_t *buf = NULL;
+  bool ok = true;
+
+  if (!S_ISREG(st.st_mode) || 0 == st.st_size) {
+    buf = crcx_fd_buf();
+    ok = NULL != buf && crcx_fd_stream(ctx, fd, buf);
+    free(buf);
+    return ok;
+  }
+
+  off_t offset = 0;
+  const off_t size = st.st_size;
+
+  while (ok && offset < size) {
+    off_t data = offset;
+    off_t hole = size;
+
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    data = lseek(fd, offset, SEEK_DATA);
+    if (-1 == data) {
+      // ENXIO: there is no more data, i.e. the file ends with a hole
+      // EINVAL: holes are not supported, so read everything
+      data = (ENXIO == errno) ? size : offset;
+    } else {
+      hole = lseek(fd, data, SEEK_HOLE);
+      if (-1 == hole) {
+        hole = size;
+      }
+    }
+    data = MIN(data, size);
+    hole = MIN(hole, size);
+#endif
+
+    D("hole: [%jd, %jd) data: [%jd, %jd)", (intmax_t)offset, (intmax_t)data,
+      (intmax_t)data, (intmax_t)hole);
+
+    crcx_zeros(ctx, (uintmax_t)(data - offset));
+    crcx_fd_map(ctx, fd, &data, hole);
+    if (data < hole && NULL == buf) {
+      buf = crcx_fd_buf();
+    }
+    ok = data == hole ||
+         (NULL != buf && crcx_fd_data(ctx, fd, buf, data, hole));
+    offset = hole;
+  }
+
+  free(buf);
+
+  return ok;
+}
+
+bool crcx_file(struct crcx_ctx *ctx, const char *path) {
+
+  if (NULL == path) {
+    errno = EINVAL;
+    return false;
+  }
+
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (-1 == fd) {
+    return false;
+  }
+
+  bool ok = crcx_fd(ctx, fd);
+  int e = errno;
+  close(fd);
+  errno = e;
+
+  return ok;
+}
+
+#else
+
+bool crcx_fd(struct crcx_ctx *ctx, int fd) {
+  (void)ctx;
+  (void)fd;
+  errno = ENOSYS;
+  return false;
+}
+
+bool crcx_file(struct crcx_ctx *ctx, const char *path) {
+  (void)ctx;
+  (void)path;
+  errno = ENOSYS;
+  return false;
+}
+
+#endif
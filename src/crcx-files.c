@@ -0,0 +1,734 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * CRC computation of many files
+ *
+ * With io_uring, a single thread keeps up to depth reads of CRCX_FILES_BLOCK
+ * bytes in flight, spread over as many files as it takes, and computes CRCs
+ * as the reads complete. Reads complete in any order, so the lfsr of each
+ * block is computed from 0 and then shifted by the number of bytes that
+ * follow it in the file with crcx_shift(). The lfsr of a file is the xor of
+ * those of its blocks and of its initial value shifted by its size, as in
+ * crcx_parallel().
+ *
+ * Without io_uring, a pool of threads computes the CRCs of whole files with
+ * crcx_fd().
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+#if !defined(_WIN32)
+#define CRCX_HAVE_PTHREAD 1
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define CRCX_HAVE_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+#endif
+
+// the size of each read
+#define CRCX_FILES_BLOCK (128 << 10)
+
+// the number of reads in flight by default, and at most
+#define CRCX_FILES_DEPTH 64
+#define CRCX_FILES_DEPTH_MAX 1024
+
+// the maximum number of threads used without io_uring
+#define CRCX_FILES_THREADS_MAX 64
+
+#if defined(CRCX_HAVE_PTHREAD)
+
+struct crcx_files_job {
+  const struct crcx_ctx *ctx;
+  const char *const *paths;
+  size_t count;
+  uintmax_t *crcs;
+  int *errors;
+  size_t next;
+  pthread_mutex_t lock;
+};
+
+static void crcx_files_result(struct crcx_files_job *job, size_t i,
+                              uintmax_t crc, int error) {
+  job->crcs[i] = 0 == error ? crc : (uintmax_t)-1;
+  job->errors[i] = error;
+}
+
+// compute the CRC of the file at index i with a context that may be modified
+static void crcx_files_one(struct crcx_files_job *job, struct crcx_ctx *ctx,
+                           size_t i) {
+  ctx->lfsr = crcx_lfsr_init(ctx);
+  if (crcx_file(ctx, job->paths[i])) {
+    crcx_files_result(job, i, crcx_fini(ctx), 0);
+  } else {
+    crcx_files_result(job, i, 0, 0 != errno ? errno : EIO);
+  }
+}
+
+static struct crcx_ctx *crcx_files_ctx(const struct crcx_ctx *ctx) {
+  struct crcx_ctx *copy = (struct crcx_ctx *)malloc(sizeof(*copy));
+  if (NULL != copy) {
+    memcpy(copy, ctx, sizeof(*copy));
+  }
+  return copy;
+}
+
+static void *crcx_files_worker(void *arg) {
+  struct crcx_files_job *job = (struct crcx_files_job *)arg;
+  struct crcx_ctx *ctx = crcx_files_ctx(job->ctx);
+
+  for (;;) {
+    pthread_mutex_lock(&job->lock);
+    const size_t i = job->next;
+    job->next += i < job->count;
+    pthread_mutex_unlock(&job->lock);
+
+    if (i == job->count) {
+      break;
+    }
+
+    if (NULL == ctx) {
+      crcx_files_result(job, i, 0, ENOMEM);
+    } else {
+      crcx_files_one(job, ctx, i);
+    }
+  }
+
+  free(ctx);
+
+  return NULL;
+}
+
+static bool crcx_files_threads(struct crcx_files_job *job, unsigned depth) {
+  pthread_t thread[CRCX_FILES_THREADS_MAX];
+  unsigned threads = (unsigned)MIN(depth, job->count);
+  unsigned started = 0;
+
+  threads = MIN(threads, CRCX_FILES_THREADS_MAX);
+
+  if (0 != pthread_mutex_init(&job->lock, NULL)) {
+    return false;
+  }
+
+  // the calling thread is one of the workers
+  for (unsigned i = 1; i < threads; ++i) {
+    if (0 != pthread_create(&thread[started], NULL, crcx_files_worker, job)) {
+      D("failed to start thread %u", i);
+      break;
+    }
+    ++started;
+  }
+
+  crcx_files_worker(job);
+
+  for (unsigned i = 0; i < started; ++i) {
+    pthread_join(thread[i], NULL);
+  }
+
+  pthread_mutex_destroy(&job->lock);
+
+  return true;
+}
+
+#if defined(CRCX_HAVE_URING)
+
+struct crcx_uring {
+  int fd;
+  bool fixed;
+
+  void *sq_ring;
+  size_t sq_size;
+  unsigned *sq_tail;
+  unsigned sq_mask;
+  unsigned *sq_array;
+  struct io_uring_sqe *sqes;
+  size_t sqes_size;
+  unsigned to_submit;
+
+  void *cq_ring;
+  size_t cq_size;
+  unsigned *cq_head;
+  unsigned *cq_tail;
+  unsigned cq_mask;
+  struct io_uring_cqe *cqes;
+};
+
+// the state of a file whose blocks are being read
+struct crcx_uring_file {
+  int fd;
+  int error;
+  bool done;
+  unsigned inflight;
+  uintmax_t size;
+  uintmax_t next;
+  uintmax_t lfsr;
+};
+
+// a read in flight, identified by its index in user_data and buf_index
+struct crcx_uring_slot {
+  size_t file;
+  uintmax_t offset;
+  size_t len;
+  uint8_t *buf;
+  bool busy;
+};
+
+// the user_data of the requests that cancel a read
+#define CRCX_URING_CANCEL ((uint64_t)1 << 63)
+
+static void crcx_uring_exit(struct crcx_uring *ring) {
+  if (NULL != ring->sqes) {
+    munmap(ring->sqes, ring->sqes_size);
+  }
+  if (NULL != ring->cq_ring && ring->cq_ring != ring->sq_ring) {
+    munmap(ring->cq_ring, ring->cq_size);
+  }
+  if (NULL != ring->sq_ring) {
+    munmap(ring->sq_ring, ring->sq_size);
+  }
+  close(ring->fd);
+}
+
+static bool crcx_uring_init(struct crcx_uring *ring, unsigned entries) {
+  struct io_uring_params p;
+
+  memset(ring, 0, sizeof(*ring));
+  memset(&p, 0, sizeof(p));
+
+  ring->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+  if (ring->fd < 0) {
+    D("io_uring_setup failed: %d", errno);
+    // seccomp filters and kernel.io_uring_disabled give EPERM
+    if (EPERM == errno || EINVAL == errno) {
+      errno = ENOSYS;
+    }
+    return false;
+  }
+
+  ring->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  ring->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    ring->sq_size = ring->cq_size = MAX(ring->sq_size, ring->cq_size);
+  }
+
+  void *sq = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  if (MAP_FAILED == sq) {
+    crcx_uring_exit(ring);
+    return false;
+  }
+  ring->sq_ring = sq;
+
+  void *cq = sq;
+  if (!(p.features & IORING_FEAT_SINGLE_MMAP)) {
+    cq = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    if (MAP_FAILED == cq) {
+      crcx_uring_exit(ring);
+      return false;
+    }
+  }
+  ring->cq_ring = cq;
+
+  ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+  void *sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (MAP_FAILED == sqes) {
+    ring->sqes = NULL;
+    crcx_uring_exit(ring);
+    return false;
+  }
+  ring->sqes = (struct io_uring_sqe *)sqes;
+
+  ring->sq_tail = (unsigned *)((uint8_t *)sq + p.sq_off.tail);
+  ring->sq_mask = *(unsigned *)((uint8_t *)sq + p.sq_off.ring_mask);
+  ring->sq_array = (unsigned *)((uint8_t *)sq + p.sq_off.array);
+  ring->cq_head = (unsigned *)((uint8_t *)cq + p.cq_off.head);
+  ring->cq_tail = (unsigned *)((uint8_t *)cq + p.cq_off.tail);
+  ring->cq_mask = *(unsigned *)((uint8_t *)cq + p.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *)((uint8_t *)cq + p.cq_off.cqes);
+
+  return true;
+}
+
+// return true if the kernel supports IORING_OP_READ, i.e. Linux 5.6 or later
+static bool crcx_uring_probe(struct crcx_uring *ring) {
+  const size_t n = IORING_OP_READ + 1;
+  struct io_uring_probe *probe = (struct io_uring_probe *)calloc(
+      1, sizeof(*probe) + n * sizeof(struct io_uring_probe_op));
+  bool ok = false;
+
+  // before Linux 5.6, IORING_REGISTER_PROBE fails with EINVAL
+  if (NULL != probe &&
+      0 == syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PROBE,
+                   probe, (unsigned)n)) {
+    ok = probe->ops_len > IORING_OP_READ &&
+         (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+  }
+
+  free(probe);
+
+  return ok;
+}
+
+static struct io_uring_sqe *crcx_uring_sqe(struct crcx_uring *ring) {
+  // this thread is the only producer
+  const unsigned i = *ring->sq_tail & ring->sq_mask;
+  struct io_uring_sqe *sqe = &ring->sqes[i];
+
+  memset(sqe, 0, sizeof(*sqe));
+  ring->sq_array[i] = i;
+
+  return sqe;
+}
+
+static void crcx_uring_push(struct crcx_uring *ring) {
+  __atomic_store_n(ring->sq_tail, *ring->sq_tail + 1, __ATOMIC_RELEASE);
+  ++ring->to_submit;
+}
+
+static void crcx_uring_read(struct crcx_uring *ring, int fd,
+                            struct crcx_uring_slot *slot, unsigned index) {
+  struct io_uring_sqe *sqe = crcx_uring_sqe(ring);
+
+  sqe->opcode = ring->fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  sqe->fd = fd;
+  sqe->addr = (uintptr_t)slot->buf;
+  sqe->len = (unsigned)slot->len;
+  sqe->off = slot->offset;
+  sqe->buf_index = ring->fixed ? (uint16_t)index : 0;
+  sqe->user_data = index;
+
+  crcx_uring_push(ring);
+}
+
+static void crcx_uring_cancel(struct crcx_uring *ring, unsigned index) {
+  struct io_uring_sqe *sqe = crcx_uring_sqe(ring);
+
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = index;
+  sqe->user_data = CRCX_URING_CANCEL | index;
+
+  crcx_uring_push(ring);
+}
+
+static bool crcx_uring_enter(struct crcx_uring *ring) {
+  for (;;) {
+    long r = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, 1,
+                     IORING_ENTER_GETEVENTS, NULL, 0);
+    if (r >= 0) {
+      ring->to_submit -= (unsigned)r;
+      return true;
+    }
+    if (EINTR != errno && EAGAIN != errno && EBUSY != errno) {
+      D("io_uring_enter failed: %d", errno);
+      return false;
+    }
+  }
+}
+
+// the state shared by the functions below
+struct crcx_uring_job {
+  struct crcx_files_job *job;
+  struct crcx_ctx *tmp;
+  struct crcx_uring_file *file;
+  struct crcx_uring_slot *slot;
+  unsigned *free;
+  unsigned nfree;
+  unsigned *retry;
+  unsigned nretry;
+  unsigned inflight;
+  size_t cursor;
+};
+
+static void crcx_uring_done(struct crcx_uring_job *u, size_t i) {
+  struct crcx_uring_file *f = &u->file[i];
+
+  close(f->fd);
+  f->done = true;
+  crcx_files_result(u->job, i, crcx_lfsr_fini(u->job->ctx, f->lfsr), f->error);
+}
+
+// open the file at the cursor, returning true if it has blocks to read
+static bool crcx_uring_open(struct crcx_uring_job *u) {
+  const struct crcx_ctx *ctx = u->job->ctx;
+  const size_t i = u->cursor;
+  struct crcx_uring_file *f = &u->file[i];
+  struct stat st;
+
+  f->done = true;
+  f->fd = open(u->job->paths[i], O_RDONLY | O_CLOEXEC);
+  if (-1 == f->fd) {
+    crcx_files_result(u->job, i, 0, errno);
+    return false;
+  }
+
+  if (-1 == fstat(f->fd, &st) || !S_ISREG(st.st_mode) || 0 == st.st_size) {
+    // e.g. pipes and procfs, which are read until the end
+    close(f->fd);
+    crcx_files_one(u->job, u->tmp, i);
+    return false;
+  }
+
+  f->done = false;
+
+  f->size = (uintmax_t)st.st_size;
+  f->lfsr = crcx_shift(ctx, crcx_lfsr_init(ctx), f->size);
+
+  return true;
+}
+
+// start reads until all slots are in use or all files are being read
+static void crcx_uring_fill(struct crcx_uring_job *u, struct crcx_uring *ring) {
+
+  for (; 0 != u->nretry; --u->nretry) {
+    const unsigned s = u->retry[u->nretry - 1];
+    crcx_uring_read(ring, u->file[u->slot[s].file].fd, &u->slot[s], s);
+  }
+
+  while (0 != u->nfree && u->cursor < u->job->count) {
+    struct crcx_uring_file *f = &u->file[u->cursor];
+
+    if (0 == f->size && !crcx_uring_open(u)) {
+      ++u->cursor;
+      continue;
+    }
+
+    const unsigned s = u->free[--u->nfree];
+    struct crcx_uring_slot *slot = &u->slot[s];
+    slot->busy = true;
+    slot->file = u->cursor;
+    slot->offset = f->next;
+    slot->len = (size_t)MIN((uintmax_t)CRCX_FILES_BLOCK, f->size - f->next);
+    crcx_uring_read(ring, f->fd, slot, s);
+
+    ++f->inflight;
+    ++u->inflight;
+    f->next += slot->len;
+    if (f->next == f->size) {
+      ++u->cursor;
+    }
+  }
+}
+
+static void crcx_uring_complete(struct crcx_uring_job *u, unsigned s,
+                                int res) {
+  const struct crcx_ctx *ctx = u->job->ctx;
+  struct crcx_uring_slot *slot = &u->slot[s];
+  struct crcx_uring_file *f = &u->file[slot->file];
+
+  if (-EAGAIN == res || -EINTR == res) {
+    u->retry[u->nretry++] = s;
+    return;
+  }
+
+  if (res <= 0) {
+    f->error = 0 == res ? EIO : -res;
+  } else {
+    const uintmax_t lfsr = ctx->update(ctx, 0, slot->buf, (size_t)res);
+    const uintmax_t end = slot->offset + (uintmax_t)res;
+    f->lfsr ^= crcx_shift(ctx, lfsr, f->size - end);
+    if ((size_t)res < slot->len && 0 == f->error) {
+      // a short read, so read the rest of the block
+      slot->offset = end;
+      slot->len -= (size_t)res;
+      u->retry[u->nretry++] = s;
+      return;
+    }
+  }
+
+  --f->inflight;
+  --u->inflight;
+  slot->busy = false;
+  u->free[u->nfree++] = s;
+
+  if (0 != f->error && f->next != f->size) {
+    // stop reading the file
+    f->next = f->size;
+    if (u->cursor == slot->file) {
+      ++u->cursor;
+    }
+  }
+
+  if (0 == f->inflight && f->next == f->size) {
+    crcx_uring_done(u, slot->file);
+  }
+}
+
+static void crcx_uring_reap(struct crcx_uring_job *u, struct crcx_uring *ring,
+                            bool cancelled) {
+  unsigned head = *ring->cq_head;
+  const unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+
+  for (; head != tail; ++head) {
+    const struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+    const unsigned s = (unsigned)cqe->user_data;
+    if (0 != (cqe->user_data & CRCX_URING_CANCEL)) {
+      continue;
+    }
+    if (cancelled) {
+      u->slot[s].busy = false;
+      --u->inflight;
+    } else {
+      crcx_uring_complete(u, s, cqe->res);
+    }
+  }
+
+  __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+// cancel the reads in flight and wait until the kernel no longer writes to
+// their buffers, which closing the ring does not do, as it is torn down
+// asynchronously
+static bool crcx_uring_drain(struct crcx_uring_job *u, struct crcx_uring *ring,
+                             unsigned depth) {
+  // reads to retry are not in flight, and are cancelled without completing
+  u->inflight -= u->nretry;
+  u->nretry = 0;
+
+  for (unsigned s = 0; s < depth; ++s) {
+    if (u->slot[s].busy) {
+      crcx_uring_cancel(ring, s);
+    }
+  }
+
+  while (0 != u->inflight) {
+    if (!crcx_uring_enter(ring)) {
+      return false;
+    }
+    crcx_uring_reap(u, ring, true);
+  }
+
+  return true;
+}
+
+static bool crcx_files_uring(struct crcx_files_job *job, unsigned depth) {
+  struct crcx_uring ring;
+  struct crcx_uring_job u;
+  struct iovec *iov = NULL;
+  uint8_t *bufs = NULL;
+  bool ok = false;
+  int e;
+
+  // room for a cancellation per read in flight
+  if (!crcx_uring_init(&ring, 2 * depth)) {
+    return false;
+  }
+
+  memset(&u, 0, sizeof(u));
+  u.job = job;
+  u.tmp = crcx_files_ctx(job->ctx);
+  u.file = (struct crcx_uring_file *)calloc(job->count, sizeof(*u.file));
+  u.slot = (struct crcx_uring_slot *)calloc(depth, sizeof(*u.slot));
+  u.free = (unsigned *)calloc(depth, sizeof(*u.free));
+  u.retry = (unsigned *)calloc(depth, sizeof(*u.retry));
+  iov = (struct iovec *)calloc(depth, sizeof(*iov));
+  if (NULL == u.tmp || NULL == u.file || NULL == u.slot || NULL == u.free ||
+      NULL == u.retry || NULL == iov ||
+      0 != posix_memalign((void **)&bufs, (size_t)sysconf(_SC_PAGESIZE),
+                          (size_t)depth * CRCX_FILES_BLOCK)) {
+    errno = ENOMEM;
+    goto out;
+  }
+
+  for (unsigned i = 0; i < depth; ++i) {
+    u.slot[i].buf = &bufs[(size_t)i * CRCX_FILES_BLOCK];
+    u.free[u.nfree++] = depth - 1 - i;
+    iov[i].iov_base = u.slot[i].buf;
+    iov[i].iov_len = CRCX_FILES_BLOCK;
+  }
+
+  // registered buffers save mapping them for every read, if memlock allows
+  ring.fixed = 0 == syscall(__NR_io_uring_register, ring.fd,
+                            IORING_REGISTER_BUFFERS, iov, depth);
+
+  // IORING_OP_READ_FIXED is available since Linux 5.1, IORING_OP_READ only
+  // since Linux 5.6
+  if (!ring.fixed && !crcx_uring_probe(&ring)) {
+    D("io_uring does not support IORING_OP_READ");
+    errno = ENOSYS;
+    goto out;
+  }
+
+  for (;;) {
+    crcx_uring_fill(&u, &ring);
+    if (0 == u.inflight) {
+      break;
+    }
+
+    if (!crcx_uring_enter(&ring)) {
+      break;
+    }
+
+    crcx_uring_reap(&u, &ring, false);
+  }
+
+  // only io_uring_enter() failing leaves reads in flight
+  ok = 0 == u.inflight;
+  e = errno;
+  if (!ok && !crcx_uring_drain(&u, &ring, depth)) {
+    // the kernel may still write to the buffers, so leak them
+    D("failed to cancel %u reads", u.inflight);
+    bufs = NULL;
+  }
+
+  for (size_t i = 0; !ok && i < job->count; ++i) {
+    if (!u.file[i].done) {
+      if (0 != u.file[i].size) {
+        close(u.file[i].fd);
+      }
+      crcx_files_result(job, i, 0, e);
+    }
+  }
+
+  errno = e;
+
+out:
+  crcx_uring_exit(&ring);
+  free(bufs);
+  free(iov);
+  free(u.retry);
+  free(u.free);
+  free(u.slot);
+  free(u.file);
+  free(u.tmp);
+
+  return ok;
+}
+
+#endif /* defined(CRCX_HAVE_URING) */
+
+bool crcx_files(const struct crcx_ctx *ctx, const char *const *paths,
+                size_t count, uintmax_t *crcs, int *errors, unsigned depth,
+                enum crcx_io io) {
+  struct crcx_files_job job;
+  bool ok = false;
+
+  if (NULL == ctx || NULL == ctx->update || (0 != count && NULL == paths) ||
+      (0 != count && NULL == crcs)) {
+    errno = EINVAL;
+    return false;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == paths[i]) {
+      errno = EINVAL;
+      return false;
+    }
+  }
+
+  if (0 == count) {
+    return true;
+  }
+
+  int *e = NULL != errors ? errors : (int *)calloc(count, sizeof(*e));
+  if (NULL == e) {
+    return false;
+  }
+
+  depth = 0 == depth ? CRCX_FILES_DEPTH : MIN(depth, CRCX_FILES_DEPTH_MAX);
+
+  job.ctx = ctx;
+  job.paths = paths;
+  job.count = count;
+  job.crcs = crcs;
+  job.errors = e;
+  job.next = 0;
+
+  switch (io) {
+  case CRCX_IO_AUTO:
+  case CRCX_IO_URING:
+#if defined(CRCX_HAVE_URING)
+    ok = crcx_files_uring(&job, depth);
+#else
+    errno = ENOSYS;
+#endif
+    if (ok || CRCX_IO_URING == io) {
+      break;
+    }
+    /* fall through */
+  case CRCX_IO_THREADS:
+    ok = crcx_files_threads(&job, depth);
+    break;
+  default:
+    errno = EINVAL;
+    break;
+  }
+
+  for (size_t i = 0; ok && i < count; ++i) {
+    if (0 != e[i]) {
+      errno = e[i];
+      ok = false;
+    }
+  }
+
+  if (e != errors) {
+    free(e);
+  }
+
+  return ok;
+}
+
+#else
+
+bool crcx_files(const struct crcx_ctx *ctx, const char *const *paths,
+                size_t count, uintmax_t *crcs, int *errors, unsigned depth,
+                enum crcx_io io) {
+  (void)ctx;
+  (void)paths;
+  (void)count;
+  (void)crcs;
+  (void)errors;
+  (void)depth;
+  (void)io;
+  errno = ENOSYS;
+  return false;
+}
+
+#endif /* defined(CRCX_HAVE_PTHREAD) */
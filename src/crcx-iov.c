@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * CRC computation of scattered buffers
+ *
+ * The lfsr is carried from one segment to the next in a register, so that a
+ * chain of segments costs no more than one call to crcx() per segment. Short
+ * segments would be processed a byte at a time by the folding kernels, so
+ * runs of them are gathered into a small buffer first.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+#if !defined(_WIN32)
+
+#include <sys/uio.h>
+
+// the size of the buffer that gathers short segments
+#define CRCX_IOV_GATHER 512
+
+bool crcx_v(struct crcx_ctx *ctx, const struct iovec *iov, int cnt) {
+  uint8_t buf[CRCX_IOV_GATHER];
+  size_t used = 0;
+
+  if (NULL == ctx || NULL == ctx->update || cnt < 0 ||
+      (NULL == iov && 0 != cnt)) {
+    return false;
+  }
+
+  // byte-wise lookups gain nothing from contiguous input
+  const bool gather = CRCX_KERNEL_TABLE != ctx->kernel;
+  const crcx_kernel_fn update = ctx->update;
+  uintmax_t lfsr = ctx->lfsr;
+
+  for (int i = 0; i < cnt; ++i) {
+    const uint8_t *data = (const uint8_t *)iov[i].iov_base;
+    const size_t len = iov[i].iov_len;
+
+    // e.g. {NULL, 0}, which must not be passed to memcpy()
+    if (0 == len) {
+      continue;
+    }
+
+    if (gather && len < CRCX_CLMUL_MIN) {
+      if (used + len > sizeof(buf)) {
+        lfsr = update(ctx, lfsr, buf, used);
+        used = 0;
+      }
+      memcpy(&buf[used], data, len);
+      used += len;
+      continue;
+    }
+
+    if (0 != used) {
+      lfsr = update(ctx, lfsr, buf, used);
+      used = 0;
+    }
+    lfsr = update(ctx, lfsr, data, len);
+  }
+
+  ctx->lfsr = update(ctx, lfsr, buf, used);
+
+  return true;
+}
+
+#endif /* !defined(_WIN32) */
@@ -0,0 +1,305 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Catalogue of standard CRC models
+ *
+ * The parameters, names and aliases follow the Catalogue of parametrised CRC
+ * algorithms by Greg Cook. The check value of each model is its CRC of the
+ * ASCII string "123456789".
+ *
+ * @see <a href="https://reveng.sourceforge.io/crc-catalogue/all.htm">Catalogue
+ * of parametrised CRC algorithms</a>
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+// clang-format off
+static const struct crcx_model crcx_catalogue[] = {
+    // name, n, poly, init, fini, reflect_input, reflect_output, check
+    {"CRC-3/GSM", 3, 0x3, 0x0, 0x7, false, false, 0x4},
+    {"CRC-3/ROHC", 3, 0x3, 0x7, 0x0, true, true, 0x6},
+    {"CRC-4/G-704", 4, 0x3, 0x0, 0x0, true, true, 0x7},
+    {"CRC-4/INTERLAKEN", 4, 0x3, 0xf, 0xf, false, false, 0xb},
+    {"CRC-5/EPC-C1G2", 5, 0x09, 0x09, 0x00, false, false, 0x00},
+    {"CRC-5/G-704", 5, 0x15, 0x00, 0x00, true, true, 0x07},
+    {"CRC-5/USB", 5, 0x05, 0x1f, 0x1f, true, true, 0x19},
+    {"CRC-6/CDMA2000-A", 6, 0x27, 0x3f, 0x00, false, false, 0x0d},
+    {"CRC-6/CDMA2000-B", 6, 0x07, 0x3f, 0x00, false, false, 0x3b},
+    {"CRC-6/DARC", 6, 0x19, 0x00, 0x00, true, true, 0x26},
+    {"CRC-6/G-704", 6, 0x03, 0x00, 0x00, true, true, 0x06},
+    {"CRC-6/GSM", 6, 0x2f, 0x00, 0x3f, false, false, 0x13},
+    {"CRC-7/MMC", 7, 0x09, 0x00, 0x00, false, false, 0x75},
+    {"CRC-7/ROHC", 7, 0x4f, 0x7f, 0x00, true, true, 0x53},
+    {"CRC-7/UMTS", 7, 0x45, 0x00, 0x00, false, false, 0x61},
+    {"CRC-8/AUTOSAR", 8, 0x2f, 0xff, 0xff, false, false, 0xdf},
+    {"CRC-8/BLUETOOTH", 8, 0xa7, 0x00, 0x00, true, true, 0x26},
+    {"CRC-8/CDMA2000", 8, 0x9b, 0xff, 0x00, false, false, 0xda},
+    {"CRC-8/DARC", 8, 0x39, 0x00, 0x00, true, true, 0x15},
+    {"CRC-8/DVB-S2", 8, 0xd5, 0x00, 0x00, false, false, 0xbc},
+    {"CRC-8/GSM-A", 8, 0x1d, 0x00, 0x00, false, false, 0x37},
+    {"CRC-8/GSM-B", 8, 0x49, 0x00, 0xff, false, false, 0x94},
+    {"CRC-8/HITAG", 8, 0x1d, 0xff, 0x00, false, false, 0xb4},
+    {"CRC-8/I-432-1", 8, 0x07, 0x00, 0x55, false, false, 0xa1},
+    {"CRC-8/I-CODE", 8, 0x1d, 0xfd, 0x00, false, false, 0x7e},
+    {"CRC-8/LTE", 8, 0x9b, 0x00, 0x00, false, false, 0xea},
+    {"CRC-8/MAXIM-DOW", 8, 0x31, 0x00, 0x00, true, true, 0xa1},
+    {"CRC-8/MIFARE-MAD", 8, 0x1d, 0xc7, 0x00, false, false, 0x99},
+    {"CRC-8/NRSC-5", 8, 0x31, 0xff, 0x00, false, false, 0xf7},
+    {"CRC-8/OPENSAFETY", 8, 0x2f, 0x00, 0x00, false, false, 0x3e},
+    {"CRC-8/ROHC", 8, 0x07, 0xff, 0x00, true, true, 0xd0},
+    {"CRC-8/SAE-J1850", 8, 0x1d, 0xff, 0xff, false, false, 0x4b},
+    {"CRC-8/SMBUS", 8, 0x07, 0x00, 0x00, false, false, 0xf4},
+    {"CRC-8/TECH-3250", 8, 0x1d, 0xff, 0x00, true, true, 0x97},
+    {"CRC-8/WCDMA", 8, 0x9b, 0x00, 0x00, true, true, 0x25},
+    {"CRC-10/ATM", 10, 0x233, 0x000, 0x000, false, false, 0x199},
+    {"CRC-10/CDMA2000", 10, 0x3d9, 0x3ff, 0x000, false, false, 0x233},
+    {"CRC-10/GSM", 10, 0x175, 0x000, 0x3ff, false, false, 0x12a},
+    {"CRC-11/FLEXRAY", 11, 0x385, 0x01a, 0x000, false, false, 0x5a3},
+    {"CRC-11/UMTS", 11, 0x307, 0x000, 0x000, false, false, 0x061},
+    {"CRC-12/CDMA2000", 12, 0xf13, 0xfff, 0x000, false, false, 0xd4d},
+    {"CRC-12/DECT", 12, 0x80f, 0x000, 0x000, false, false, 0xf5b},
+    {"CRC-12/GSM", 12, 0xd31, 0x000, 0xfff, false, false, 0xb34},
+    {"CRC-12/UMTS", 12, 0x80f, 0x000, 0x000, false, true, 0xdaf},
+    {"CRC-13/BBC", 13, 0x1cf5, 0x0000, 0x0000, false, false, 0x04fa},
+    {"CRC-14/DARC", 14, 0x0805, 0x0000, 0x0000, true, true, 0x082d},
+    {"CRC-14/GSM", 14, 0x202d, 0x0000, 0x3fff, false, false, 0x30ae},
+    {"CRC-15/CAN", 15, 0x4599, 0x0000, 0x0000, false, false, 0x059e},
+    {"CRC-15/MPT1327", 15, 0x6815, 0x0000, 0x0001, false, false, 0x2566},
+    {"CRC-16/ARC", 16, 0x8005, 0x0000, 0x0000, true, true, 0xbb3d},
+    {"CRC-16/CDMA2000", 16, 0xc867, 0xffff, 0x0000, false, false, 0x4c06},
+    {"CRC-16/CMS", 16, 0x8005, 0xffff, 0x0000, false, false, 0xaee7},
+    {"CRC-16/DDS-110", 16, 0x8005, 0x800d, 0x0000, false, false, 0x9ecf},
+    {"CRC-16/DECT-R", 16, 0x0589, 0x0000, 0x0001, false, false, 0x007e},
+    {"CRC-16/DECT-X", 16, 0x0589, 0x0000, 0x0000, false, false, 0x007f},
+    {"CRC-16/DNP", 16, 0x3d65, 0x0000, 0xffff, true, true, 0xea82},
+    {"CRC-16/EN-13757", 16, 0x3d65, 0x0000, 0xffff, false, false, 0xc2b7},
+    {"CRC-16/GENIBUS", 16, 0x1021, 0xffff, 0xffff, false, false, 0xd64e},
+    {"CRC-16/GSM", 16, 0x1021, 0x0000, 0xffff, false, false, 0xce3c},
+    {"CRC-16/IBM-3740", 16, 0x1021, 0xffff, 0x0000, false, false, 0x29b1},
+    {"CRC-16/IBM-SDLC", 16, 0x1021, 0xffff, 0xffff, true, true, 0x906e},
+    {"CRC-16/ISO-IEC-14443-3-A", 16, 0x1021, 0xc6c6, 0x0000, true, true, 0xbf05},
+    {"CRC-16/KERMIT", 16, 0x1021, 0x0000, 0x0000, true, true, 0x2189},
+    {"CRC-16/LJ1200", 16, 0x6f63, 0x0000, 0x0000, false, false, 0xbdf4},
+    {"CRC-16/M17", 16, 0x5935, 0xffff, 0x0000, false, false, 0x772b},
+    {"CRC-16/MAXIM-DOW", 16, 0x8005, 0x0000, 0xffff, true, true, 0x44c2},
+    {"CRC-16/MCRF4XX", 16, 0x1021, 0xffff, 0x0000, true, true, 0x6f91},
+    {"CRC-16/MODBUS", 16, 0x8005, 0xffff, 0x0000, true, true, 0x4b37},
+    {"CRC-16/NRSC-5", 16, 0x080b, 0xffff, 0x0000, true, true, 0xa066},
+    {"CRC-16/OPENSAFETY-A", 16, 0x5935, 0x0000, 0x0000, false, false, 0x5d38},
+    {"CRC-16/OPENSAFETY-B", 16, 0x755b, 0x0000, 0x0000, false, false, 0x20fe},
+    {"CRC-16/PROFIBUS", 16, 0x1dcf, 0xffff, 0xffff, false, false, 0xa819},
+    {"CRC-16/RIELLO", 16, 0x1021, 0xb2aa, 0x0000, true, true, 0x63d0},
+    {"CRC-16/SPI-FUJITSU", 16, 0x1021, 0x1d0f, 0x0000, false, false, 0xe5cc},
+    {"CRC-16/T10-DIF", 16, 0x8bb7, 0x0000, 0x0000, false, false, 0xd0db},
+    {"CRC-16/TELEDISK", 16, 0xa097, 0x0000, 0x0000, false, false, 0x0fb3},
+    {"CRC-16/TMS37157", 16, 0x1021, 0x89ec, 0x0000, true, true, 0x26b1},
+    {"CRC-16/UMTS", 16, 0x8005, 0x0000, 0x0000, false, false, 0xfee8},
+    {"CRC-16/USB", 16, 0x8005, 0xffff, 0xffff, true, true, 0xb4c8},
+    {"CRC-16/XMODEM", 16, 0x1021, 0x0000, 0x0000, false, false, 0x31c3},
+    {"CRC-17/CAN-FD", 17, 0x1685b, 0x00000, 0x00000, false, false, 0x04f03},
+    {"CRC-21/CAN-FD", 21, 0x102899, 0x000000, 0x000000, false, false, 0x0ed841},
+    {"CRC-24/BLE", 24, 0x00065b, 0x555555, 0x000000, true, true, 0xc25a56},
+    {"CRC-24/FLEXRAY-A", 24, 0x5d6dcb, 0xfedcba, 0x000000, false, false, 0x7979bd},
+    {"CRC-24/FLEXRAY-B", 24, 0x5d6dcb, 0xabcdef, 0x000000, false, false, 0x1f23b8},
+    {"CRC-24/INTERLAKEN", 24, 0x328b63, 0xffffff, 0xffffff, false, false, 0xb4f3e6},
+    {"CRC-24/LTE-A", 24, 0x864cfb, 0x000000, 0x000000, false, false, 0xcde703},
+    {"CRC-24/LTE-B", 24, 0x800063, 0x000000, 0x000000, false, false, 0x23ef52},
+    {"CRC-24/OPENPGP", 24, 0x864cfb, 0xb704ce, 0x000000, false, false, 0x21cf02},
+    {"CRC-24/OS-9", 24, 0x800063, 0xffffff, 0xffffff, false, false, 0x200fa5},
+    {"CRC-30/CDMA", 30, 0x2030b9c7, 0x3fffffff, 0x3fffffff, false, false, 0x04c34abf},
+    {"CRC-31/PHILIPS", 31, 0x04c11db7, 0x7fffffff, 0x7fffffff, false, false, 0x0ce9e46c},
+    {"CRC-32/AIXM", 32, 0x814141ab, 0x00000000, 0x00000000, false, false, 0x3010bf7f},
+    {"CRC-32/AUTOSAR", 32, 0xf4acfb13, 0xffffffff, 0xffffffff, true, true, 0x1697d06a},
+    {"CRC-32/BASE91-D", 32, 0xa833982b, 0xffffffff, 0xffffffff, true, true, 0x87315576},
+    {"CRC-32/BZIP2", 32, 0x04c11db7, 0xffffffff, 0xffffffff, false, false, 0xfc891918},
+    {"CRC-32/CD-ROM-EDC", 32, 0x8001801b, 0x00000000, 0x00000000, true, true, 0x6ec2edc4},
+    {"CRC-32/CKSUM", 32, 0x04c11db7, 0x00000000, 0xffffffff, false, false, 0x765e7680},
+    {"CRC-32/ISCSI", 32, 0x1edc6f41, 0xffffffff, 0xffffffff, true, true, 0xe3069283},
+    {"CRC-32/ISO-HDLC", 32, 0x04c11db7, 0xffffffff, 0xffffffff, true, true, 0xcbf43926},
+    {"CRC-32/JAMCRC", 32, 0x04c11db7, 0xffffffff, 0x00000000, true, true, 0x340bc6d9},
+    {"CRC-32/MEF", 32, 0x741b8cd7, 0xffffffff, 0x00000000, true, true, 0xd2c22f51},
+    {"CRC-32/MPEG-2", 32, 0x04c11db7, 0xffffffff, 0x00000000, false, false, 0x0376e6e7},
+    {"CRC-32/XFER", 32, 0x000000af, 0x00000000, 0x00000000, false, false, 0xbd0be338},
+    {"CRC-40/GSM", 40, 0x0004820009, 0x0000000000, 0xffffffffff, false, false, 0xd4164fc646},
+    {"CRC-64/ECMA-182", 64, 0x42f0e1eba9ea3693, 0x0000000000000000, 0x0000000000000000, false, false, 0x6c40df5f0b497347},
+    {"CRC-64/GO-ISO", 64, 0x000000000000001b, 0xffffffffffffffff, 0xffffffffffffffff, true, true, 0xb90956c775a41001},
+    {"CRC-64/MS", 64, 0x259c84cba6426349, 0xffffffffffffffff, 0x0000000000000000, true, true, 0x75d4b74f024eceea},
+    {"CRC-64/NVME", 64, 0xad93d23594c93659, 0xffffffffffffffff, 0xffffffffffffffff, true, true, 0xae8b14860a799888},
+    {"CRC-64/REDIS", 64, 0xad93d23594c935a9, 0x0000000000000000, 0x0000000000000000, true, true, 0xe9c6d914c4b8d9ca},
+    {"CRC-64/WE", 64, 0x42f0e1eba9ea3693, 0xffffffffffffffff, 0xffffffffffffffff, false, false, 0x62ec59e3f1a4f00a},
+    {"CRC-64/XZ", 64, 0x42f0e1eba9ea3693, 0xffffffffffffffff, 0xffffffffffffffff, true, true, 0x995dc9bbdf1939fa},
+};
+
+static const struct {
+  const char *alias;
+  const char *name;
+} crcx_aliases[] = {
+    {"CRC-4/ITU", "CRC-4/G-704"},
+    {"CRC-5/EPC", "CRC-5/EPC-C1G2"},
+    {"CRC-5/ITU", "CRC-5/G-704"},
+    {"CRC-6/ITU", "CRC-6/G-704"},
+    {"CRC-7", "CRC-7/MMC"},
+    {"CRC-8/ITU", "CRC-8/I-432-1"},
+    {"CRC-8/MAXIM", "CRC-8/MAXIM-DOW"},
+    {"DOW-CRC", "CRC-8/MAXIM-DOW"},
+    {"CRC-8", "CRC-8/SMBUS"},
+    {"CRC-8/AES", "CRC-8/TECH-3250"},
+    {"CRC-8/EBU", "CRC-8/TECH-3250"},
+    {"CRC-10", "CRC-10/ATM"},
+    {"CRC-10/I-610", "CRC-10/ATM"},
+    {"CRC-11", "CRC-11/FLEXRAY"},
+    {"X-CRC-12", "CRC-12/DECT"},
+    {"CRC-12/3GPP", "CRC-12/UMTS"},
+    {"CRC-15", "CRC-15/CAN"},
+    {"ARC", "CRC-16/ARC"},
+    {"CRC-16", "CRC-16/ARC"},
+    {"CRC-16/LHA", "CRC-16/ARC"},
+    {"CRC-IBM", "CRC-16/ARC"},
+    {"R-CRC-16", "CRC-16/DECT-R"},
+    {"X-CRC-16", "CRC-16/DECT-X"},
+    {"CRC-16/DARC", "CRC-16/GENIBUS"},
+    {"CRC-16/EPC", "CRC-16/GENIBUS"},
+    {"CRC-16/EPC-C1G2", "CRC-16/GENIBUS"},
+    {"CRC-16/I-CODE", "CRC-16/GENIBUS"},
+    {"CRC-16/AUTOSAR", "CRC-16/IBM-3740"},
+    {"CRC-16/CCITT-FALSE", "CRC-16/IBM-3740"},
+    {"CRC-16/ISO-HDLC", "CRC-16/IBM-SDLC"},
+    {"CRC-16/ISO-IEC-14443-3-B", "CRC-16/IBM-SDLC"},
+    {"CRC-16/X-25", "CRC-16/IBM-SDLC"},
+    {"CRC-B", "CRC-16/IBM-SDLC"},
+    {"X-25", "CRC-16/IBM-SDLC"},
+    {"CRC-A", "CRC-16/ISO-IEC-14443-3-A"},
+    {"CRC-16/BLUETOOTH", "CRC-16/KERMIT"},
+    {"CRC-16/CCITT", "CRC-16/KERMIT"},
+    {"CRC-16/CCITT-TRUE", "CRC-16/KERMIT"},
+    {"CRC-16/V-41-LSB", "CRC-16/KERMIT"},
+    {"CRC-CCITT", "CRC-16/KERMIT"},
+    {"KERMIT", "CRC-16/KERMIT"},
+    {"CRC-16/MAXIM", "CRC-16/MAXIM-DOW"},
+    {"MODBUS", "CRC-16/MODBUS"},
+    {"CRC-16/IEC-61158-2", "CRC-16/PROFIBUS"},
+    {"CRC-16/AUG-CCITT", "CRC-16/SPI-FUJITSU"},
+    {"CRC-16/BUYPASS", "CRC-16/UMTS"},
+    {"CRC-16/VERIFONE", "CRC-16/UMTS"},
+    {"CRC-16/ACORN", "CRC-16/XMODEM"},
+    {"CRC-16/LTE", "CRC-16/XMODEM"},
+    {"CRC-16/V-41-MSB", "CRC-16/XMODEM"},
+    {"XMODEM", "CRC-16/XMODEM"},
+    {"ZMODEM", "CRC-16/XMODEM"},
+    {"CRC-24", "CRC-24/OPENPGP"},
+    {"CRC-32Q", "CRC-32/AIXM"},
+    {"CRC-32D", "CRC-32/BASE91-D"},
+    {"CRC-32/AAL5", "CRC-32/BZIP2"},
+    {"CRC-32/DECT-B", "CRC-32/BZIP2"},
+    {"B-CRC-32", "CRC-32/BZIP2"},
+    {"CKSUM", "CRC-32/CKSUM"},
+    {"CRC-32/POSIX", "CRC-32/CKSUM"},
+    {"CRC-32/BASE91-C", "CRC-32/ISCSI"},
+    {"CRC-32/CASTAGNOLI", "CRC-32/ISCSI"},
+    {"CRC-32/INTERLAKEN", "CRC-32/ISCSI"},
+    {"CRC-32C", "CRC-32/ISCSI"},
+    {"CRC-32", "CRC-32/ISO-HDLC"},
+    {"CRC-32/ADCCP", "CRC-32/ISO-HDLC"},
+    {"CRC-32/V-42", "CRC-32/ISO-HDLC"},
+    {"CRC-32/XZ", "CRC-32/ISO-HDLC"},
+    {"PKZIP", "CRC-32/ISO-HDLC"},
+    {"JAMCRC", "CRC-32/JAMCRC"},
+    {"XFER", "CRC-32/XFER"},
+    {"CRC-64/GO-ECMA", "CRC-64/XZ"},
+};
+// clang-format on
+
+// compare ASCII strings ignoring case
+static bool crcx_name_eq(const char *a, const char *b) {
+  for (; *a && *b; ++a, ++b) {
+    char x = ('a' <= *a && *a <= 'z') ? *a - 'a' + 'A' : *a;
+    char y = ('a' <= *b && *b <= 'z') ? *b - 'a' + 'A' : *b;
+    if (x != y) {
+      return false;
+    }
+  }
+  return *a == *b;
+}
+
+const struct crcx_model *crcx_models(size_t *count) {
+  if (NULL != count) {
+    *count = ARRAY_SIZE(crcx_catalogue);
+  }
+
+  return crcx_catalogue;
+}
+
+const struct crcx_model *crcx_find_model(const char *name) {
+
+  if (NULL == name) {
+    return NULL;
+  }
+
+  for (size_t i = 0; i < ARRAY_SIZE(crcx_aliases); ++i) {
+    if (crcx_name_eq(name, crcx_aliases[i].alias)) {
+      name = crcx_aliases[i].name;
+      break;
+    }
+  }
+
+  for (size_t i = 0; i < ARRAY_SIZE(crcx_catalogue); ++i) {
+    if (crcx_name_eq(name, crcx_catalogue[i].name)) {
+      return &crcx_catalogue[i];
+    }
+  }
+
+  D("unknown model: %s", name);
+
+  return NULL;
+}
+
+bool crcx_init_model(struct crcx_ctx *ctx, const char *name) {
+  const struct crcx_model *model = crcx_find_model(name);
+
+  if (NULL == ctx || NULL == model) {
+    return false;
+  }
+
+  return crcx_init(ctx, model->n, model->poly, model->init, model->fini,
+                   model->reflect_input, model->reflect_output);
+}
+
+bool crcx_check_model(const struct crcx_model *model) {
+  struct crcx_ctx ctx;
+
+  if (NULL == model ||
+      !crcx_init(&ctx, model->n, model->poly, model->init, model->fini,
+                 model->reflect_input, model->reflect_output)) {
+    return false;
+  }
+
+  crcx(&ctx, "123456789", 9);
+
+  return crcx_fini(&ctx) == model->check;
+}
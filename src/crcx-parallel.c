@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Parallel CRC computation
+ *
+ * The input is split into one contiguous chunk per thread. Each thread
+ * computes the lfsr of its chunk, starting from 0, with the kernel the context
+ * is bound to. The lfsrs are then merged in order by appending the length of
+ * each chunk to the running lfsr with crcx_shift() and xor'ing in the lfsr of
+ * the chunk.
+ */
+
+#include <stdint.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+#if !defined(_WIN32)
+#define CRCX_HAVE_PTHREAD 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// the minimum number of bytes per thread for which starting a thread pays off
+#define CRCX_PARALLEL_MIN (1 << 20)
+
+// the maximum number of threads used by crcx_parallel()
+#define CRCX_PARALLEL_MAX 256
+
+// the chunks are aligned so that the kernels do not process partial blocks
+#define CRCX_PARALLEL_ALIGN 64
+
+#if defined(CRCX_HAVE_PTHREAD)
+
+struct crcx_job {
+  const struct crcx_ctx *ctx;
+  const uint8_t *data;
+  size_t len;
+  uintmax_t lfsr;
+  pthread_t thread;
+  bool started;
+};
+
+static void *crcx_job_run(void *arg) {
+  struct crcx_job *job = (struct crcx_job *)arg;
+
+  job->lfsr = job->ctx->update(job->ctx, 0, job->data, job->len);
+
+  return NULL;
+}
+
+static unsigned crcx_ncpu(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (unsigned)n : 1;
+}
+
+bool crcx_parallel(struct crcx_ctx *ctx, const void *data, const size_t len,
+                   unsigned threads) {
+  struct crcx_job job[CRCX_PARALLEL_MAX];
+
+  if (NULL == ctx || NULL == ctx->update) {
+    return false;
+  }
+
+  if (0 == threads) {
+    threads = crcx_ncpu();
+  }
+
+  threads = (unsigned)MIN(threads, len / CRCX_PARALLEL_MIN);
+  threads = MIN(threads, CRCX_PARALLEL_MAX);
+  if (threads <= 1) {
+    return crcx(ctx, data, len);
+  }
+
+  const size_t chunk = len / threads & ~(size_t)(CRCX_PARALLEL_ALIGN - 1);
+  const uint8_t *p = (const uint8_t *)data;
+  for (unsigned i = 0; i < threads; ++i, p += chunk) {
+    job[i].ctx = ctx;
+    job[i].data = p;
+    job[i].len = (i == threads - 1) ? len - i * chunk : chunk;
+    job[i].started = false;
+  }
+
+  D("%u threads, %zu bytes each", threads, chunk);
+
+  // the calling thread processes the first chunk
+  for (unsigned i = 1; i < threads; ++i) {
+    job[i].started =
+        0 == pthread_create(&job[i].thread, NULL, crcx_job_run, &job[i]);
+  }
+
+  crcx_job_run(&job[0]);
+
+  uintmax_t lfsr = ctx->lfsr;
+  for (unsigned i = 0; i < threads; ++i) {
+    if (job[i].started) {
+      pthread_join(job[i].thread, NULL);
+    } else if (i > 0) {
+      D("failed to start thread %u", i);
+      crcx_job_run(&job[i]);
+    }
+    lfsr = crcx_shift(ctx, lfsr, job[i].len) ^ job[i].lfsr;
+  }
+
+  ctx->lfsr = lfsr;
+
+  return true;
+}
+
+#else
+
+bool crcx_parallel(struct crcx_ctx *ctx, const void *data, const size_t len,
+                   unsigned threads) {
+  (void)threads;
+  return crcx(ctx, data, len);
+}
+
+#endif
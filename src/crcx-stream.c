@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * CRC streams sharing a read-only context, and a pool to allocate them from
+ */
+
+#include <stdint.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+bool crcx_stream_init(struct crcx_stream *stream, const struct crcx_ctx *ctx) {
+
+  if (NULL == stream || NULL == ctx || NULL == ctx->update) {
+    return false;
+  }
+
+  stream->ctx = ctx;
+  stream->lfsr = crcx_lfsr_init(ctx);
+
+  return true;
+}
+
+bool crcx_stream_update(struct crcx_stream *stream, const void *data,
+                        const size_t len) {
+
+  if (!crcx_stream_valid(stream)) {
+    return false;
+  }
+
+  stream->lfsr = stream->ctx->update(stream->ctx, stream->lfsr,
+                                     (const uint8_t *)data, len);
+
+  return true;
+}
+
+uintmax_t crcx_stream_fini(struct crcx_stream *stream) {
+  uintmax_t r;
+
+  if (!crcx_stream_valid(stream)) {
+    return -1;
+  }
+
+  r = crcx_lfsr_fini(stream->ctx, stream->lfsr);
+  stream->lfsr = crcx_lfsr_init(stream->ctx);
+
+  return r;
+}
+
+// A stream that was put back links to the next one through the pointer to
+// its context, tagged with CRCX_POOL_FREE. Streams that were never handed out
+// are not linked, so that initializing a pool takes constant time.
+static inline struct crcx_stream *crcx_pool_next(struct crcx_stream *stream) {
+  return (struct crcx_stream *)((uintptr_t)stream->ctx & ~CRCX_POOL_FREE);
+}
+
+static inline void crcx_pool_link(struct crcx_stream *stream,
+                                  struct crcx_stream *next) {
+  stream->ctx = (const struct crcx_ctx *)((uintptr_t)next | CRCX_POOL_FREE);
+}
+
+bool crcx_pool_init(struct crcx_pool *pool, struct crcx_stream *streams,
+                    size_t capacity) {
+
+  if (NULL == pool || (NULL == streams && capacity > 0)) {
+    return false;
+  }
+
+  pool->streams = streams;
+  pool->capacity = capacity;
+  pool->used = 0;
+  pool->next = 0;
+  pool->free = NULL;
+
+  return true;
+}
+
+struct crcx_stream *crcx_pool_get(struct crcx_pool *pool,
+                                  const struct crcx_ctx *ctx) {
+  struct crcx_stream *stream;
+
+  if (NULL == pool || NULL == ctx || NULL == ctx->update) {
+    return NULL;
+  }
+
+  if (NULL != pool->free) {
+    stream = pool->free;
+    pool->free = crcx_pool_next(stream);
+  } else if (pool->next < pool->capacity) {
+    stream = &pool->streams[pool->next++];
+  } else {
+    D("pool exhausted: %zu streams", pool->capacity);
+    return NULL;
+  }
+
+  ++pool->used;
+  crcx_stream_init(stream, ctx);
+
+  return stream;
+}
+
+bool crcx_pool_put(struct crcx_pool *pool, struct crcx_stream *stream) {
+
+  if (NULL == pool || NULL == stream || 0 == pool->used) {
+    return false;
+  }
+
+  // only streams that were handed out, and not put back since
+  const uintptr_t offset = (uintptr_t)stream - (uintptr_t)pool->streams;
+  if ((uintptr_t)stream < (uintptr_t)pool->streams ||
+      0 != offset % sizeof(*stream) || offset / sizeof(*stream) >= pool->next ||
+      !crcx_stream_valid(stream)) {
+    return false;
+  }
+
+  crcx_pool_link(stream, pool->free);
+  pool->free = stream;
+  --pool->used;
+
+  return true;
+}
@@ -0,0 +1,139 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Table-driven CRC computation
+ *
+ * The kernels are specialised for each table width by crcx/_table.h, so that
+ * CRCs of up to 32 bits use 32-bit arithmetic and tables of 8, 16 or 32-bit
+ * entries.
+ */
+
+#include <stdint.h>
+
+#include "crcx/_private.h"
+#include "crcx/crcx.h"
+
+#define W 8
+#define T uint8_t
+#define R uint32_t
+#define TABLE table8
+#include "crcx/_table.h"
+
+#define W 16
+#define T uint16_t
+#define R uint32_t
+#define TABLE table16
+#include "crcx/_table.h"
+
+#define W 32
+#define T uint32_t
+#define R uint32_t
+#define TABLE table32
+#include "crcx/_table.h"
+
+#define W 64
+#define T uint64_t
+#define R uint64_t
+#define TABLE table64
+#include "crcx/_table.h"
+
+crcx_kernel_fn crcx_table_kernel(const struct crcx_ctx *ctx, bool slicing) {
+  switch (crcx_width(ctx->n)) {
+  case 8:
+    return slicing ? crcx_slicing8 : crcx_table8;
+  case 16:
+    return slicing ? crcx_slicing16 : crcx_table16;
+  case 32:
+    return slicing ? crcx_slicing32 : crcx_table32;
+  default:
+    return slicing ? crcx_slicing64 : crcx_table64;
+  }
+}
+
+crcx_lanes_fn crcx_lanes_kernel(const struct crcx_ctx *ctx) {
+  switch (crcx_width(ctx->n)) {
+  case 8:
+    return crcx_lanes8;
+  case 16:
+    return crcx_lanes16;
+  case 32:
+    return crcx_lanes32;
+  default:
+    return crcx_lanes64;
+  }
+}
+
+uintmax_t crcx_slicing(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                       const uint8_t *data, size_t len) {
+  return crcx_table_kernel(ctx, true)(ctx, lfsr, data, len);
+}
+
+void crcx_update(struct crcx_ctx *ctx, uint8_t data) {
+  ctx->lfsr = crcx_table_kernel(ctx, false)(ctx, ctx->lfsr, &data, 1);
+}
+
+/*
+ * Process the first @p nbits (1 to 7) bits of @p data, in the order of the
+ * input, i.e. starting from the most-significant bit unless the input is
+ * reflected.
+ *
+ * No separate table is needed: leading zero bits do not change a zero
+ * register, so the table entry of a byte whose first 8 - @p nbits bits are
+ * zero is the CRC of its last @p nbits bits. In the normal bit order, that is
+ * entry @p b for the bits @p b. In the reflected bit order, it is entry
+ * @p b << (8 - @p nbits).
+ */
+static uintmax_t crcx_partial(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                              uint8_t data, uint8_t nbits) {
+  const uint8_t w = crcx_width(ctx->n);
+  const uint8_t bits = (1 << nbits) - 1;
+
+  if (ctx->reflect_input) {
+    const uint8_t i = (lfsr ^ data) & bits;
+    return (lfsr >> nbits) ^ crcx_table_get(ctx->table8, w, i << (8 - nbits));
+  }
+
+  // keep the register left-aligned, like the table
+  const uint8_t k = w - ctx->n;
+  const uintmax_t mask = ctx->mask << k;
+  const uint8_t i = ((lfsr << k) >> (w - nbits)) ^ (data >> (8 - nbits));
+  lfsr = ((lfsr << (k + nbits)) & mask) ^ crcx_table_get(ctx->table8, w, i);
+
+  return lfsr >> k;
+}
+
+bool crcx_update_bits(struct crcx_ctx *ctx, const void *data, size_t nbits) {
+  const uint8_t *p = (const uint8_t *)data;
+
+  if (!crcx(ctx, data, nbits / 8)) {
+    return false;
+  }
+
+  if (0 != nbits % 8) {
+    ctx->lfsr = crcx_partial(ctx, ctx->lfsr, p[nbits / 8], nbits % 8);
+  }
+
+  return true;
+}
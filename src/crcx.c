@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "crcx/_private.h"
 #include "crcx/crcx.h"
 
 #ifdef _MSC_VER
@@ -39,36 +40,30 @@
 #error "Unhandled processor"
 #endif
 #endif /* _MSC_VER */
-#ifndef MAX
-#define MAX(a, b) ((a) >= (b) ? (a) : (b))
-#endif
 
-#ifndef MIN
-#define MIN(a, b) ((a) <= (b) ? (a) : (b))
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
 #endif
 
-#if defined(DEBUG)
-#include <stdio.h>
-#define D(fmt, ...)                                                            \
-  printf("%s(): %d: " fmt "\n", __func__, __LINE__, __VA_ARGS__)
-#else
-#define D(fmt, ...)
+#if !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
 #endif
 
 #if defined(DEBUG)
 
 static void crc_print_table(const struct crcx_ctx *ctx) {
-  const size_t nibbles_per_entry = ctx->n / 4;
+  const uint8_t w = crcx_width(ctx->n);
+  const size_t nibbles_per_entry = w / 4;
   const size_t cols_per_row = 8;
   const size_t cols = cols_per_row;
-  const size_t rows = ARRAY_SIZE(ctx->table) / cols_per_row;
+  const size_t rows = ARRAY_SIZE(ctx->table8) / cols_per_row;
 
   char fmt[16];
-  snprintf(fmt, sizeof(fmt), "%%0%" PRIxMAX "x ", nibbles_per_entry);
+  snprintf(fmt, sizeof(fmt), "%%0%zu" PRIx64 " ", nibbles_per_entry);
 
   for (size_t row = 0; row < rows; ++row) {
     for (size_t col = 0; col < cols; ++col) {
-      printf(fmt, ctx->table[row * cols + col]);
+      printf(fmt, crcx_table_get(ctx->table8, w, row * cols + col));
     }
     putchar('\n');
   }
@@ -77,21 +72,70 @@ static void crc_print_table(const struct crcx_ctx *ctx) {
 static inline void crc_print_table(const struct crcx_ctx *ctx) { (void)ctx; }
 #endif
 
-// This can probably be done nibble-wise with a LUT and a bunch of shift in
-// constant time followed by a shift corresponding to the leading number of
-// zeros
+// the result of the first call to crcx_cpu() plus CRCX_CPU_PROBED
+#if !defined(__STDC_NO_ATOMICS__)
+static atomic_uint crcx_cpu_features;
+#else
+static unsigned crcx_cpu_features;
+#endif
+#define CRCX_CPU_PROBED (1U << 31)
+
+unsigned crcx_cpu(void) {
+  unsigned features = crcx_cpu_features;
+
+  // racing threads store the same value
+  if (features & CRCX_CPU_PROBED) {
+    return features & ~CRCX_CPU_PROBED;
+  }
+
+  features = 0;
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    if ((ecx & bit_PCLMUL) && (ecx & bit_SSSE3) && (ecx & bit_SSE4_1)) {
+      features |= CRCX_CPU_CLMUL;
+    }
+    if (ecx & bit_SSE4_2) {
+      features |= CRCX_CPU_CRC32C;
+    }
+  }
+#endif
+
+  D("cpu features: %x", features);
+
+  crcx_cpu_features = features | CRCX_CPU_PROBED;
+
+  return features;
+}
+
+// Bit-reversed bytes, generated 2 bits at a time
+#define R2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define R4(n) R2(n), R2(n + 2 * 16), R2(n + 1 * 16), R2(n + 3 * 16)
+#define R6(n) R4(n), R4(n + 2 * 4), R4(n + 1 * 4), R4(n + 3 * 4)
+static const uint8_t crcx_reflected_bytes[256] = {R6(0), R6(2), R6(1), R6(3)};
+#undef R2
+#undef R4
+#undef R6
+
+// Reflects every byte with a LUT while swapping the byte order, then shifts
+// the result down by the number of unused bits. This takes constant time.
 uintmax_t crcx_reflect(const uintmax_t x, const uint8_t n) {
 
   const uint8_t _n = MIN(n, 8 * sizeof(uintmax_t));
 
+  if (0 == _n) {
+    return 0;
+  }
+
   uintmax_t y = 0;
 
-  for (size_t i = 0; i < _n; ++i) {
-    bool bit = (x >> i) & 1;
-    y |= bit << ((_n - 1) - i);
+  for (size_t i = 0; i < sizeof(uintmax_t); ++i) {
+    y <<= 8;
+    y |= crcx_reflected_bytes[(uint8_t)(x >> (8 * i))];
   }
 
-  return y;
+  return y >> (8 * sizeof(uintmax_t) - _n);
 }
 
 bool crcx_valid(const struct crcx_ctx *ctx) {
@@ -106,7 +150,7 @@ bool crcx_valid(const struct crcx_ctx *ctx) {
     return false;
   }
 
-  if (0 == ctx->n || ctx->n > 8 * sizeof(uintmax_t) || 0 != ctx->n % 8) {
+  if (0 == ctx->n || ctx->n > 8 * sizeof(uintmax_t)) {
     D("invalid value for ctx->n: %u", ctx->n);
     return false;
   }
@@ -143,24 +187,51 @@ bool crcx_valid(const struct crcx_ctx *ctx) {
 }
 
 bool crcx_generate_table(struct crcx_ctx *ctx) {
-  uintmax_t *table = (uintmax_t *)ctx->table;
 
   if (!crcx_valid(ctx)) {
     return false;
   }
 
-  table[0] = 0;
-  uintmax_t crc = ctx->msb;
-  for (size_t i = 1; i < 256; i <<= 1) {
-    if (crc & ctx->msb) {
-      crc <<= 1;
-      crc ^= ctx->poly;
-    } else {
-      crc <<= 1;
+  void *table = (void *)ctx->table8;
+  const uint8_t w = crcx_width(ctx->n);
+
+  crcx_table_set(table, w, 0, 0);
+
+  if (ctx->reflect_input) {
+    // LSB-first: the bits of the register and of the polynomial are reversed
+    // and the register shifts right
+    const uint64_t poly = crcx_reflect(ctx->poly & ctx->mask, ctx->n);
+    uint64_t crc = 1;
+    for (size_t i = 128; i > 0; i >>= 1) {
+      if (crc & 1) {
+        crc >>= 1;
+        crc ^= poly;
+      } else {
+        crc >>= 1;
+      }
+      for (size_t j = 0; j < 256; j += 2 * i) {
+        crcx_table_set(table, w, i ^ j, crc ^ crcx_table_get(table, w, j));
+      }
     }
-    crc &= ctx->mask;
-    for (size_t j = 0; j < i; ++j) {
-      table[i ^ j] = crc ^ table[j];
+  } else {
+    // MSB-first: the register and the polynomial are aligned to the most
+    // significant bit of the table entries
+    const uint8_t k = w - ctx->n;
+    const uint64_t msb = (uint64_t)1 << (w - 1);
+    const uint64_t mask = (uint64_t)ctx->mask << k;
+    const uint64_t poly = (uint64_t)(ctx->poly & ctx->mask) << k;
+    uint64_t crc = msb;
+    for (size_t i = 1; i < 256; i <<= 1) {
+      if (crc & msb) {
+        crc <<= 1;
+        crc ^= poly;
+      } else {
+        crc <<= 1;
+      }
+      crc &= mask;
+      for (size_t j = 0; j < i; ++j) {
+        crcx_table_set(table, w, i ^ j, crc ^ crcx_table_get(table, w, j));
+      }
     }
   }
 
@@ -169,11 +240,22 @@ bool crcx_generate_table(struct crcx_ctx *ctx) {
   return true;
 }
 
-#define SET(t, k, v) *((t *)(&(k))) = (v)
+typedef const void *crcx_slice_t;
+
+void crcx_derive(struct crcx_ctx *ctx) {
+  memset((uint64_t *)ctx->table64, 0, sizeof(ctx->table64));
+  crcx_generate_table(ctx);
+  crcx_zeros_init(ctx);
+  crcx_clmul_init(ctx);
+  crcx_crc32c_init(ctx);
+}
 
 bool crcx_init(struct crcx_ctx *ctx, uint8_t n, uintmax_t poly, uintmax_t init,
                uintmax_t fini, bool reflect_input, bool reflect_output) {
 
+  SET(enum crcx_kernel, ctx->kernel, CRCX_KERNEL_NONE);
+  SET(crcx_kernel_fn, ctx->update, NULL);
+
   SET(uint8_t, ctx->n, n);
   SET(uintmax_t, ctx->poly, poly);
   SET(bool, ctx->reflect_input, reflect_input);
@@ -193,60 +275,164 @@ bool crcx_init(struct crcx_ctx *ctx, uint8_t n, uintmax_t poly, uintmax_t init,
     return false;
   }
 
-  ctx->lfsr = ctx->init;
-  memset((uintmax_t *)ctx->table, 0, sizeof(ctx->table));
-  return crcx_generate_table(ctx);
+  ctx->lfsr = crcx_lfsr_init(ctx);
+  SET(uint8_t, ctx->slices, 0);
+  SET(crcx_slice_t, ctx->slice, NULL);
+  crcx_cache_load(ctx);
+
+  const unsigned cpu = crcx_cpu();
+  SET(bool, ctx->clmul, 0 != (cpu & CRCX_CPU_CLMUL));
+
+  if (crcx_crc32c_match(ctx) && (cpu & CRCX_CPU_CRC32C)) {
+    return crcx_set_kernel(ctx, CRCX_KERNEL_CRC32C);
+  }
+
+  if (ctx->clmul) {
+    return crcx_set_kernel(ctx, CRCX_KERNEL_CLMUL);
+  }
+
+  return crcx_set_kernel(ctx, CRCX_KERNEL_TABLE);
 }
 
 uintmax_t crcx_fini(struct crcx_ctx *ctx) {
   uintmax_t r;
 
-  if (!crcx_valid(ctx)) {
+  if (NULL == ctx || NULL == ctx->update) {
     return -1;
   }
 
-  ctx->lfsr ^= ctx->fini;
-  ctx->lfsr &= ctx->mask;
-  D("lfsr: %" PRIxMAX, ctx->lfsr);
+  r = crcx_lfsr_fini(ctx, ctx->lfsr);
+  D("lfsr: %" PRIxMAX " crc: %" PRIxMAX, ctx->lfsr, r);
 
-  if (ctx->reflect_output) {
-    ctx->lfsr = crcx_reflect(ctx->lfsr, ctx->n);
-    D("lfsr: %" PRIxMAX, ctx->lfsr);
-  }
-
-  r = ctx->lfsr;
-  ctx->lfsr = ctx->init;
+  ctx->lfsr = crcx_lfsr_init(ctx);
 
   return r;
 }
 
-void crcx_update(struct crcx_ctx *ctx, uint8_t data) {
+bool crcx_generate_slices(struct crcx_ctx *ctx, void *tables, size_t size,
+                          uint8_t slices) {
 
-  if (ctx->reflect_input) {
-    D("reflecting: %02x => %02x", data, (uint8_t)crcx_reflect(data, 8));
-    data = (uint8_t)crcx_reflect(data, 8);
+  if (!crcx_valid(ctx)) {
+    return false;
+  }
+
+  const uint8_t w = crcx_width(ctx->n);
+
+  if (0 == slices) {
+    SET(uint8_t, ctx->slices, 0);
+    SET(crcx_slice_t, ctx->slice, NULL);
+    if (CRCX_KERNEL_SLICING == ctx->kernel) {
+      return crcx_set_kernel(ctx, CRCX_KERNEL_TABLE);
+    }
+    return true;
+  }
+
+  if (!(4 == slices || 8 == slices || 16 == slices)) {
+    D("invalid number of slices: %u", slices);
+    return false;
+  }
+
+  if (NULL == tables || size < (size_t)slices * 256 * (w / 8)) {
+    D("insufficient storage for %u slices: %zu", slices, size);
+    return false;
   }
 
-  // https://en.wikipedia.org/wiki/Computation_of_cyclic_redundancy_checks#Multi-bit_computation
-  uint8_t upper_byte = (uint8_t)(ctx->lfsr >> (ctx->n - 8));
-  uint8_t idx = data ^ upper_byte;
+  // one table after another, with 256 entries each
+  memcpy(tables, ctx->table8, 256 * (w / 8));
+  for (size_t k = 1; k < slices; ++k) {
+    for (size_t i = 0; i < 256; ++i) {
+      // append one zero byte to the message described by slice[k - 1][i]
+      uint64_t crc = crcx_table_get(tables, w, 256 * (k - 1) + i);
+      if (ctx->reflect_input) {
+        crc = (crc >> 8) ^ crcx_table_get(ctx->table8, w, (uint8_t)crc);
+      } else {
+        crc = (crc << 8) ^
+              crcx_table_get(ctx->table8, w, (uint8_t)(crc >> (w - 8)));
+      }
+      crcx_table_set(tables, w, 256 * k + i, crc);
+    }
+  }
 
-  ctx->lfsr <<= 8;
-  ctx->lfsr &= ctx->mask;
-  ctx->lfsr ^= ctx->table[idx];
+  SET(crcx_slice_t, ctx->slice, tables);
+  SET(uint8_t, ctx->slices, slices);
+
+  if (CRCX_KERNEL_TABLE == ctx->kernel) {
+    return crcx_set_kernel(ctx, CRCX_KERNEL_SLICING);
+  }
 
-  D("data: %u lfsr: %" PRIxMAX, data, ctx->lfsr);
+  return true;
 }
 
 bool crcx(struct crcx_ctx *ctx, const void *data, const size_t len) {
 
+  if (NULL == ctx || NULL == ctx->update) {
+    return false;
+  }
+
+  ctx->lfsr = ctx->update(ctx, ctx->lfsr, (const uint8_t *)data, len);
+
+  return true;
+}
+
+enum crcx_kernel crcx_get_kernel(const struct crcx_ctx *ctx) {
+  if (NULL == ctx || NULL == ctx->update) {
+    return CRCX_KERNEL_NONE;
+  }
+
+  return ctx->kernel;
+}
+
+bool crcx_set_kernel(struct crcx_ctx *ctx, enum crcx_kernel kernel) {
+  crcx_kernel_fn update;
+
   if (!crcx_valid(ctx)) {
     return false;
   }
 
-  for (size_t i = 0; i < len; ++i) {
-    crcx_update(ctx, ((const uint8_t *)data)[i]);
+  switch (kernel) {
+  case CRCX_KERNEL_TABLE:
+    update = crcx_table_kernel(ctx, false);
+    break;
+  case CRCX_KERNEL_SLICING:
+    if (0 == ctx->slices) {
+      return false;
+    }
+    update = crcx_table_kernel(ctx, true);
+    break;
+  case CRCX_KERNEL_CLMUL:
+    if (!ctx->clmul) {
+      return false;
+    }
+    update = crcx_clmul;
+    break;
+  case CRCX_KERNEL_CRC32C:
+    if (!(crcx_crc32c_match(ctx) && (crcx_cpu() & CRCX_CPU_CRC32C))) {
+      return false;
+    }
+    update = crcx_crc32c;
+    break;
+  default:
+    return false;
   }
 
+  D("binding kernel %s", crcx_kernel_name(kernel));
+  SET(enum crcx_kernel, ctx->kernel, kernel);
+  SET(crcx_kernel_fn, ctx->update, update);
+
   return true;
 }
+
+const char *crcx_kernel_name(enum crcx_kernel kernel) {
+  switch (kernel) {
+  case CRCX_KERNEL_TABLE:
+    return "table";
+  case CRCX_KERNEL_SLICING:
+    return "slicing";
+  case CRCX_KERNEL_CLMUL:
+    return "clmul";
+  case CRCX_KERNEL_CRC32C:
+    return "crc32c";
+  default:
+    return "none";
+  }
+}
@@ -0,0 +1,289 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Internal definitions shared between the translation units of libcrcx.
+ *
+ * Nothing in this file is part of the public API.
+ */
+
+#ifndef CRCX__PRIVATE_H_
+#define CRCX__PRIVATE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crcx/crcx.h"
+
+#ifndef MAX
+#define MAX(a, b) ((a) >= (b) ? (a) : (b))
+#endif
+
+#ifndef MIN
+#define MIN(a, b) ((a) <= (b) ? (a) : (b))
+#endif
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(x) (sizeof(x) / (sizeof((x)[0])))
+#endif
+
+#if defined(DEBUG)
+#include <stdio.h>
+#define D(fmt, ...)                                                            \
+  printf("%s(): %d: " fmt "\n", __func__, __LINE__, ##__VA_ARGS__)
+#else
+#define D(fmt, ...)
+#endif
+
+// assign a value to a const-qualified member of a context
+#define SET(t, k, v) *((t *)(&(k))) = (v)
+
+// CPU features used by the kernels
+enum {
+  CRCX_CPU_CLMUL = 1 << 0,  // PCLMULQDQ, SSSE3 and SSE4.1
+  CRCX_CPU_CRC32C = 1 << 1, // SSE4.2
+};
+
+// the minimum input length for which folding outperforms table lookups
+#define CRCX_CLMUL_MIN 64
+
+// keep independent scalar computations out of vector registers, where moving
+// each lane in and out for its table lookup costs more than it saves
+#if defined(__GNUC__) && !defined(__clang__)
+#define CRCX_SCALAR __attribute__((optimize("no-tree-vectorize")))
+#else
+#define CRCX_SCALAR
+#endif
+
+// the number of messages that crcx_batch() processes in lockstep (the
+// kernels in crcx/_table.h are written out for exactly this many)
+#define CRCX_LANES 4
+
+/*
+ * Update the lfsr of CRCX_LANES independent messages with @p len bytes of
+ * each, advancing the pointers in @p data.
+ */
+typedef void (*crcx_lanes_fn)(const struct crcx_ctx *ctx, uintmax_t *lfsr,
+                              const uint8_t **data, size_t len);
+
+__BEGIN_DECLS
+
+/*
+ * The number of bits of a table entry for an @p n bit CRC.
+ */
+static inline uint8_t crcx_width(uint8_t n) {
+  return n <= 8 ? 8 : n <= 16 ? 16 : n <= 32 ? 32 : 64;
+}
+
+/*
+ * Access entry @p i of a table with @p w bit entries.
+ */
+static inline uint64_t crcx_table_get(const void *table, uint8_t w, size_t i) {
+  switch (w) {
+  case 8:
+    return ((const uint8_t *)table)[i];
+  case 16:
+    return ((const uint16_t *)table)[i];
+  case 32:
+    return ((const uint32_t *)table)[i];
+  default:
+    return ((const uint64_t *)table)[i];
+  }
+}
+
+static inline void crcx_table_set(void *table, uint8_t w, size_t i,
+                                  uint64_t v) {
+  switch (w) {
+  case 8:
+    ((uint8_t *)table)[i] = (uint8_t)v;
+    break;
+  case 16:
+    ((uint16_t *)table)[i] = (uint16_t)v;
+    break;
+  case 32:
+    ((uint32_t *)table)[i] = (uint32_t)v;
+    break;
+  default:
+    ((uint64_t *)table)[i] = v;
+    break;
+  }
+}
+
+/*
+ * Streams that were put back in a pool link to the next free one through
+ * their ctx, with this bit set so that they are not mistaken for streams in
+ * use. Pointers to contexts and streams are at least 2-byte aligned.
+ */
+#define CRCX_POOL_FREE ((uintptr_t)1)
+
+/*
+ * Whether @p stream was initialized and not put back in a pool.
+ */
+static inline bool crcx_stream_valid(const struct crcx_stream *stream) {
+  return NULL != stream && NULL != stream->ctx &&
+         0 == ((uintptr_t)stream->ctx & CRCX_POOL_FREE);
+}
+
+/*
+ * The value of the lfsr before any data is processed.
+ */
+static inline uintmax_t crcx_lfsr_init(const struct crcx_ctx *ctx) {
+  return ctx->reflect_input ? crcx_reflect(ctx->init, ctx->n) : ctx->init;
+}
+
+/*
+ * Finalize @p lfsr, i.e. apply @ref crcx_ctx.fini and @ref
+ * crcx_ctx.reflect_output. The lfsr is already reflected when
+ * @ref crcx_ctx.reflect_input is set.
+ */
+static inline uintmax_t crcx_lfsr_fini(const struct crcx_ctx *ctx,
+                                       uintmax_t lfsr) {
+  if (ctx->reflect_input != ctx->reflect_output) {
+    lfsr = crcx_reflect(lfsr, ctx->n);
+  }
+  lfsr ^= ctx->reflect_output ? crcx_reflect(ctx->fini, ctx->n) : ctx->fini;
+  return lfsr & ctx->mask;
+}
+
+/*
+ * The inverse of @ref crcx_lfsr_fini.
+ */
+static inline uintmax_t crcx_lfsr_unfini(const struct crcx_ctx *ctx,
+                                         uintmax_t crc) {
+  crc ^= ctx->reflect_output ? crcx_reflect(ctx->fini, ctx->n) : ctx->fini;
+  if (ctx->reflect_input != ctx->reflect_output) {
+    crc = crcx_reflect(crc, ctx->n);
+  }
+  return crc & ctx->mask;
+}
+
+/*
+ * Probe the CPU for the features used by the kernels, e.g. with cpuid. The
+ * CPU is only probed once.
+ *
+ * Returns a combination of CRCX_CPU_* flags.
+ */
+unsigned crcx_cpu(void);
+
+/*
+ * Compute the data derived from the parameters of @p ctx, i.e. the table,
+ * @ref crcx_ctx.fold and @ref crcx_ctx.zeros. @p ctx must be valid.
+ */
+void crcx_derive(struct crcx_ctx *ctx);
+
+/*
+ * Load the data derived from the parameters of @p ctx from the process-wide
+ * cache. On a miss, it is computed with @ref crcx_derive and added to the
+ * cache. @p ctx must be valid.
+ */
+void crcx_cache_load(struct crcx_ctx *ctx);
+
+/*
+ * Get the table-driven kernel for the width of @p ctx, either byte-wise or
+ * slicing-by-N (when enabled).
+ */
+crcx_kernel_fn crcx_table_kernel(const struct crcx_ctx *ctx, bool slicing);
+
+/*
+ * Get the kernel for the width of @p ctx that interleaves the table lookups
+ * of CRCX_LANES messages.
+ */
+crcx_lanes_fn crcx_lanes_kernel(const struct crcx_ctx *ctx);
+
+/*
+ * Compute the CRC of @p data, starting from @p lfsr, with the table-driven
+ * implementation (slicing-by-N when enabled, otherwise byte-wise).
+ *
+ * Returns the updated lfsr. @p ctx must be valid.
+ */
+uintmax_t crcx_slicing(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                       const uint8_t *data, size_t len);
+
+/*
+ * Derive the constants used by @ref crcx_clmul in @ref crcx_ctx.fold from the
+ * CRC parameters.
+ */
+void crcx_clmul_init(struct crcx_ctx *ctx);
+
+/*
+ * Compute the CRC of @p data, starting from @p lfsr, by folding 16 bytes at a
+ * time with carry-less multiplication. Short inputs and any remaining bytes
+ * are processed with @ref crcx_slicing.
+ *
+ * Returns the updated lfsr. @p ctx must have been set up by
+ * @ref crcx_clmul_init and the CPU must support CRCX_CPU_CLMUL.
+ */
+uintmax_t crcx_clmul(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                     const uint8_t *data, size_t len);
+
+/*
+ * Check whether @p ctx describes CRC-32C (Castagnoli).
+ *
+ * Returns true if @ref crcx_crc32c may be used with @p ctx on CPUs that
+ * support CRCX_CPU_CRC32C.
+ */
+bool crcx_crc32c_match(const struct crcx_ctx *ctx);
+
+/*
+ * If @p ctx describes CRC-32C (Castagnoli), store the constants used to
+ * combine interleaved streams in @ref crcx_ctx.fold.
+ *
+ * Returns the result of @ref crcx_crc32c_match.
+ */
+bool crcx_crc32c_init(struct crcx_ctx *ctx);
+
+/*
+ * Compute the CRC-32C of @p data, starting from @p lfsr, with the crc32
+ * instruction. Three streams are interleaved if @ref crcx_ctx.clmul is set.
+ *
+ * Returns the updated lfsr.
+ */
+uintmax_t crcx_crc32c(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                      const uint8_t *data, size_t len);
+
+/*
+ * Multiply the polynomials @p a and @p b modulo @ref crcx_ctx.poly. Both are
+ * in the bit order of the lfsr.
+ */
+uintmax_t crcx_mulmod(const struct crcx_ctx *ctx, uintmax_t a, uintmax_t b);
+
+/*
+ * Compute the operators in @ref crcx_ctx.zeros.
+ */
+void crcx_zeros_init(struct crcx_ctx *ctx);
+
+/*
+ * Append @p len zero bytes to @p lfsr, i.e. multiply it by x^(8 * len) modulo
+ * @ref crcx_ctx.poly, in O(log len) time. @p ctx must have been set up by
+ * @ref crcx_zeros_init.
+ *
+ * Returns the updated lfsr. @p ctx must be valid.
+ */
+uintmax_t crcx_shift(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                     uintmax_t len);
+
+__END_DECLS
+
+#endif /* CRCX__PRIVATE_H_ */
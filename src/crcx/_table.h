@@ -0,0 +1,206 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Christopher Friedt
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Table-driven kernels for one table width
+ *
+ * This file is included by crcx-table.c once per table width, with the
+ * following macros defined:
+ *
+ *   W      the number of bits of a table entry (8, 16, 32 or 64)
+ *   T      the type of a table entry
+ *   R      the type used for arithmetic on the register (at least 32 bits)
+ *   TABLE  the member of struct crcx_ctx holding the table
+ *
+ * The register is kept in the low W bits of an R. For normal (MSB-first)
+ * models whose n is less than W, the register and the table entries are
+ * shifted left by W - n bits, so that no masking is required. Reflected
+ * models need no alignment.
+ */
+
+#define CRCX_CAT_(a, b) a##b
+#define CRCX_CAT(a, b) CRCX_CAT_(a, b)
+#define FN(name) CRCX_CAT(name, W)
+
+static inline R FN(crcx_step_normal)(const T *table, R r, uint8_t data) {
+  return (T)(r << 8) ^ table[(uint8_t)(r >> (W - 8)) ^ data];
+}
+
+static inline R FN(crcx_step_reflected)(const T *table, R r, uint8_t data) {
+  return (r >> 8) ^ table[(uint8_t)(r ^ data)];
+}
+
+static R FN(crcx_bytewise_normal)(const T *table, R r, const uint8_t *data,
+                                  size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    r = FN(crcx_step_normal)(table, r, data[i]);
+  }
+  return r;
+}
+
+static R FN(crcx_bytewise_reflected)(const T *table, R r, const uint8_t *data,
+                                     size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    r = FN(crcx_step_reflected)(table, r, data[i]);
+  }
+  return r;
+}
+
+// Each iteration folds the upper bytes of the register into the first bytes
+// of the block and looks every byte up in the table that accounts for the
+// number of bytes that follow it in the block. The compiler generates one
+// unrolled copy per constant value of slices.
+static inline R FN(crcx_slice_by_normal)(const struct crcx_ctx *ctx, R r,
+                                         const uint8_t *data, size_t len,
+                                         const uint8_t slices) {
+
+  const T(*slice)[256] = (const T(*)[256])ctx->slice;
+  const uint8_t m = MIN(W / 8, slices);
+  const bool keep = 8 * slices < W;
+
+  for (; len >= slices; len -= slices, data += slices) {
+    R crc = keep ? (T)(r << (8 * slices)) : 0;
+    uint8_t i = 0;
+    for (; i < m; ++i) {
+      crc ^= slice[slices - 1 - i][data[i] ^ (uint8_t)(r >> (W - 8 * (i + 1)))];
+    }
+    for (; i < slices; ++i) {
+      crc ^= slice[slices - 1 - i][data[i]];
+    }
+    r = crc;
+  }
+
+  return FN(crcx_bytewise_normal)(ctx->TABLE, r, data, len);
+}
+
+// The same as above with reflected tables, where the lower bytes of the
+// register are folded into the block.
+static inline R FN(crcx_slice_by_reflected)(const struct crcx_ctx *ctx, R r,
+                                            const uint8_t *data, size_t len,
+                                            const uint8_t slices) {
+
+  const T(*slice)[256] = (const T(*)[256])ctx->slice;
+  const uint8_t m = MIN(W / 8, slices);
+  const bool keep = 8 * slices < W;
+
+  for (; len >= slices; len -= slices, data += slices) {
+    R crc = keep ? r >> (8 * slices) : 0;
+    uint8_t i = 0;
+    for (; i < m; ++i) {
+      crc ^= slice[slices - 1 - i][data[i] ^ (uint8_t)(r >> (8 * i))];
+    }
+    for (; i < slices; ++i) {
+      crc ^= slice[slices - 1 - i][data[i]];
+    }
+    r = crc;
+  }
+
+  return FN(crcx_bytewise_reflected)(ctx->TABLE, r, data, len);
+}
+
+static uintmax_t FN(crcx_table)(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                                const uint8_t *data, size_t len) {
+  if (ctx->reflect_input) {
+    return FN(crcx_bytewise_reflected)(ctx->TABLE, (R)lfsr, data, len);
+  }
+
+  const uint8_t k = W - ctx->n;
+  return FN(crcx_bytewise_normal)(ctx->TABLE, (R)(lfsr << k), data, len) >> k;
+}
+
+static uintmax_t FN(crcx_slicing)(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                                  const uint8_t *data, size_t len) {
+  if (ctx->reflect_input) {
+    const R r = (R)lfsr;
+    switch (ctx->slices) {
+    case 4:
+      return FN(crcx_slice_by_reflected)(ctx, r, data, len, 4);
+    case 8:
+      return FN(crcx_slice_by_reflected)(ctx, r, data, len, 8);
+    case 16:
+      return FN(crcx_slice_by_reflected)(ctx, r, data, len, 16);
+    default:
+      return FN(crcx_bytewise_reflected)(ctx->TABLE, r, data, len);
+    }
+  }
+
+  const uint8_t k = W - ctx->n;
+  const R r = (R)(lfsr << k);
+  switch (ctx->slices) {
+  case 4:
+    return FN(crcx_slice_by_normal)(ctx, r, data, len, 4) >> k;
+  case 8:
+    return FN(crcx_slice_by_normal)(ctx, r, data, len, 8) >> k;
+  case 16:
+    return FN(crcx_slice_by_normal)(ctx, r, data, len, 16) >> k;
+  default:
+    return FN(crcx_bytewise_normal)(ctx->TABLE, r, data, len) >> k;
+  }
+}
+
+// The lookups of one message depend on each other, but those of different
+// messages do not, so that the CPU overlaps the latencies of the lookups of
+// all lanes. The lanes are spelled out so that the registers are not spilled.
+CRCX_SCALAR static void FN(crcx_lanes)(const struct crcx_ctx *ctx,
+                                       uintmax_t *lfsr, const uint8_t **data,
+                                       size_t len) {
+  const T *table = ctx->TABLE;
+  const uint8_t k = ctx->reflect_input ? 0 : W - ctx->n;
+  const uint8_t *d0 = data[0], *d1 = data[1], *d2 = data[2], *d3 = data[3];
+  R r0 = (R)(lfsr[0] << k), r1 = (R)(lfsr[1] << k), r2 = (R)(lfsr[2] << k),
+    r3 = (R)(lfsr[3] << k);
+
+  if (ctx->reflect_input) {
+    for (size_t i = 0; i < len; ++i) {
+      r0 = FN(crcx_step_reflected)(table, r0, d0[i]);
+      r1 = FN(crcx_step_reflected)(table, r1, d1[i]);
+      r2 = FN(crcx_step_reflected)(table, r2, d2[i]);
+      r3 = FN(crcx_step_reflected)(table, r3, d3[i]);
+    }
+  } else {
+    for (size_t i = 0; i < len; ++i) {
+      r0 = FN(crcx_step_normal)(table, r0, d0[i]);
+      r1 = FN(crcx_step_normal)(table, r1, d1[i]);
+      r2 = FN(crcx_step_normal)(table, r2, d2[i]);
+      r3 = FN(crcx_step_normal)(table, r3, d3[i]);
+    }
+  }
+
+  data[0] = d0 + len;
+  data[1] = d1 + len;
+  data[2] = d2 + len;
+  data[3] = d3 + len;
+  lfsr[0] = r0 >> k;
+  lfsr[1] = r1 >> k;
+  lfsr[2] = r2 >> k;
+  lfsr[3] = r3 >> k;
+}
+
+#undef FN
+#undef CRCX_CAT
+#undef CRCX_CAT_
+#undef W
+#undef T
+#undef R
+#undef TABLE
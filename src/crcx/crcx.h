@@ -61,13 +61,79 @@
 
 __BEGIN_DECLS
 
+/// The maximum number of tables that may be used for slicing-by-N
+#define CRCX_SLICES_MAX 16
+
+/**
+ * The number of bytes required to store @p slices slicing tables
+ *
+ * This is sufficient for CRCs of any width. Narrower CRCs only use the part
+ * that corresponds to the type of their table entries.
+ *
+ * @see crcx_generate_slices
+ */
+#define CRCX_SLICING_SIZE(slices) ((size_t)(slices)*256 * sizeof(uintmax_t))
+
+/**
+ * CRC implementations
+ *
+ * @ref crcx_init binds each context to the fastest implementation that
+ * is available for its parameters on the running CPU.
+ *
+ * @see crcx_get_kernel
+ * @see crcx_set_kernel
+ */
+enum crcx_kernel {
+  CRCX_KERNEL_NONE,    ///< the context is not initialized
+  CRCX_KERNEL_TABLE,   ///< one table lookup per byte
+  CRCX_KERNEL_SLICING, ///< slicing-by-N, see @ref crcx_generate_slices
+  CRCX_KERNEL_CLMUL,   ///< folding with carry-less multiplication (PCLMULQDQ)
+  CRCX_KERNEL_CRC32C,  ///< the SSE4.2 crc32 instruction (CRC-32C only)
+};
+
+struct crcx_ctx;
+struct iovec;
+
+/**
+ * The I/O engines of @ref crcx_files
+ */
+enum crcx_io {
+  CRCX_IO_AUTO,    ///< io_uring if the kernel supports it, otherwise threads
+  CRCX_IO_URING,   ///< asynchronous reads with io_uring on a single thread
+  CRCX_IO_THREADS, ///< a pool of threads, each calling @ref crcx_file
+};
+
+/**
+ * A CRC implementation
+ *
+ * Computes the CRC of @p data starting with the register value @p lfsr.
+ *
+ * @param ctx   the CRC context
+ * @param lfsr  the initial value of the linear feedback shift register
+ * @param data  the data for which the CRC should be calculated
+ * @param len   the length of @p data
+ *
+ * @return the value of the linear feedback shift register after @p data
+ */
+typedef uintmax_t (*crcx_kernel_fn)(const struct crcx_ctx *ctx, uintmax_t lfsr,
+                                    const uint8_t *data, size_t len);
+
 /**
  * CRC context
  *
  * This structure contains all of the necessary context to compute the cyclic
  * redundancy check for binary data.
- * The "normal" polynomial representation is used. It only works for CRC's that
- * are a multiple of 8 bits in length.
+ * The "normal" polynomial representation is used. It works for CRC's of any
+ * length from 1 to 64 bits.
+ *
+ * The table is stored with entries of the narrowest type that fits @p n bits,
+ * i.e. in @ref crcx_ctx.table8, @ref crcx_ctx.table16, @ref crcx_ctx.table32
+ * or @ref crcx_ctx.table64. When @ref crcx_ctx.reflect_input is set, the table
+ * and @ref crcx_ctx.lfsr are kept in the reflected (LSB-first) bit order so
+ * that no bits need to be reversed while processing data. Otherwise, the table
+ * entries of CRCs that are narrower than their type are shifted left to the
+ * most significant bits. Either way, one byte is processed per table lookup
+ * for any @p n, e.g. CRC-5/USB or CRC-15/CAN.
  *
  * @see <a href="https://en.wikipedia.org/wiki/Cyclic_redundancy_check">Cyclic
  * redundancy check (CRC)</a>
@@ -85,11 +151,91 @@ struct crcx_ctx {
   const uintmax_t msb;         ///< a bitmask used internally that is set to 1 << (@n - 1)
   const bool reflect_input;    ///< perform a bitwise reversal of each input byte
   const bool reflect_output;   ///< perform a bitwise reversal of the result of the CRC calculation
-  const uintmax_t table[256];  ///< a table used to store CRC values for individual bytes
-  uintmax_t lfsr;              ///< the modeled linear feedback shift register
+  uintmax_t lfsr;              ///< the modeled linear feedback shift register (reflected if @ref crcx_ctx.reflect_input is set)
+  const enum crcx_kernel kernel; ///< the implementation used by @ref crcx
+  const crcx_kernel_fn update; ///< the function implementing @ref crcx_ctx.kernel
+  const uint8_t slices;        ///< the number of slicing tables in use (0 to process one byte at a time)
+  const void *const slice;     ///< tables used to process @ref crcx_ctx.slices bytes at a time, with entries of the same type as the table
+  const bool clmul;            ///< the CPU supports carry-less multiplication (x86-64 with PCLMULQDQ)
+  union {
+    const uint8_t table8[256];   ///< the table for CRCs of up to 8 bits
+    const uint16_t table16[256]; ///< the table for CRCs of 9 to 16 bits
+    const uint32_t table32[256]; ///< the table for CRCs of 17 to 32 bits
+    const uint64_t table64[256]; ///< the table for CRCs of 33 to 64 bits
+  };                           ///< tables used to store CRC values for individual bytes (reflected if @ref crcx_ctx.reflect_input is set)
+  const uint64_t fold[10];     ///< constants derived from @ref crcx_ctx.poly for folding, Barrett reduction and combining interleaved streams
+  const uintmax_t zeros[64];   ///< x^(8 * 2^k) mod @ref crcx_ctx.poly in the bit order of the lfsr, which appends 2^k zero bytes
   // clang-format on
 };
 
+/**
+ * The parameters of a standard CRC model
+ *
+ * @see crcx_find_model
+ */
+struct crcx_model {
+  const char *name;    ///< the name of the model, e.g. "CRC-32/ISO-HDLC"
+  uint8_t n;           ///< number of bits in CRC
+  uintmax_t poly;      ///< the polynomial used for CRC calculations
+  uintmax_t init;      ///< initial value stored in the lfsr
+  uintmax_t fini;      ///< final value xor'ed with the lfsr
+  bool reflect_input;  ///< perform a bitwise reversal of each input byte
+  bool reflect_output; ///< perform a bitwise reversal of the result
+  uintmax_t check;     ///< the CRC of the ASCII string "123456789"
+};
+
+/**
+ * Statistics of the process-wide cache used by @ref crcx_init
+ *
+ * @see crcx_get_cache_stats
+ */
+struct crcx_cache_stats {
+  uint64_t hits;   ///< the number of contexts initialized from the cache
+  uint64_t misses; ///< the number of contexts whose tables were generated
+  size_t entries;  ///< the number of cached parameter combinations
+  size_t capacity; ///< the maximum number of cached parameter combinations
+};
+
+/**
+ * The state of a single CRC computation
+ *
+ * A stream only holds the register, and refers to a @ref crcx_ctx for the
+ * parameters and tables. Any number of streams may share one context, from
+ * any number of threads, as long as the context is not modified. This keeps
+ * the per-stream state to a few bytes and makes setting up a stream cheap.
+ *
+ * The @ref crcx_ctx.lfsr of the shared context is not used.
+ */
+struct crcx_stream {
+  const struct crcx_ctx *ctx; ///< the shared CRC parameters and tables
+  uintmax_t lfsr;             ///< the modeled linear feedback shift register
+};
+
+/**
+ * A fixed-capacity allocator for @ref crcx_stream objects
+ *
+ * The streams are stored in an array provided by the caller, so that no
+ * memory is allocated. Getting and putting a stream takes constant time.
+ *
+ * A pool is not thread-safe. Use one pool per thread, e.g. per event loop.
+ */
+struct crcx_pool {
+  struct crcx_stream *streams; ///< the storage for the streams
+  size_t capacity;             ///< the number of elements of @ref crcx_pool.streams
+  size_t used;                 ///< the number of streams in use
+  size_t next;                 ///< the number of streams ever handed out
+  struct crcx_stream *free;    ///< a list of streams that were put back
+};
+
+/**
+ * A message of a batch, see @ref crcx_batch
+ */
+struct crcx_msg {
+  struct crcx_stream *stream; ///< the stream to update with the message
+  const void *data;           ///< the contents of the message
+  size_t len;                 ///< the length of @ref crcx_msg.data
+};
+
 /**
  * Reflect the least-significant @p n bits of @p x
  *
@@ -125,13 +271,53 @@ bool crcx_valid(const struct crcx_ctx *ctx);
  */
 bool crcx_generate_table(struct crcx_ctx *ctx);
 
+/**
+ * Generate the tables used for slicing-by-N
+ *
+ * Slicing-by-N processes @p slices bytes of input per iteration by using
+ * @p slices tables derived from the table of @p ctx, with entries of the same
+ * type. Table @p k holds the CRC of each possible byte followed by @p k zero
+ * bytes.
+ *
+ * The caller provides storage for the tables so that no allocation is
+ * required. For embedded, consider either static or heap allocation:
+ *
+ * @code{.c}
+ * static uintmax_t slices[8][256];
+ * crcx_generate_slices(&ctx, slices, sizeof(slices), 8);
+ * @endcode
+ *
+ * This function must be called after @ref crcx_init, which disables
+ * slicing. Results are identical to those of byte-wise processing.
+ *
+ * @param ctx     the CRC context
+ * @param tables  storage for the slicing tables
+ * @param size    the size of @p tables in bytes. It must be at least
+ *                @p slices * 256 table entries, which
+ *                @ref CRCX_SLICING_SIZE(@p slices) always is
+ * @param slices  the number of bytes to process per iteration. One of 4, 8
+ *                or 16. Use 0 to disable slicing.
+ *
+ * @return true if the tables are generated, otherwise false
+ *
+ * @see <a
+ * href="https://en.wikipedia.org/wiki/Computation_of_cyclic_redundancy_checks#Multi-bit_computation_using_multiple_tables">Computation
+ * of cyclic redundancy checks: Multi-bit computation using multiple tables</a>
+ */
+bool crcx_generate_slices(struct crcx_ctx *ctx, void *tables, size_t size,
+                          uint8_t slices);
+
 /**
  * Initialize a CRC context with the given parameters.
  *
+ * The table is generated the first time a combination of @p n, @p poly and
+ * @p reflect_input is used, and copied from a process-wide cache afterwards
+ * (see @ref crcx_get_cache_stats).
+ *
  * Warning: @p init and @p fini will be truncated to @p n bits
  *
  * @param ctx             the CRC context to initialize
- * @param n               number of bits in CRC. For E.g. CRC-8 use 8.
+ * @param n               number of bits in CRC (1 to 64). For E.g. CRC-8 use 8.
  * @param poly            the polynomial used for CRC calculations
  * @param init            initial value stored in the @ref crcx_ctx.lfsr
  * @param fini            final value xor'ed with the @ref crcx_ctx.lfsr
@@ -144,13 +330,70 @@ bool crcx_generate_table(struct crcx_ctx *ctx);
 bool crcx_init(struct crcx_ctx *ctx, uint8_t n, uintmax_t poly, uintmax_t init,
                uintmax_t fini, bool reflect_input, bool reflect_output);
 
+/**
+ * Get the catalogue of standard CRC models
+ *
+ * The catalogue follows the Catalogue of parametrised CRC algorithms by
+ * Greg Cook (RevEng).
+ *
+ * @param count  where to store the number of models, or NULL
+ *
+ * @return the models, sorted by width and name
+ *
+ * @see <a href="https://reveng.sourceforge.io/crc-catalogue/all.htm">Catalogue
+ * of parametrised CRC algorithms</a>
+ */
+const struct crcx_model *crcx_models(size_t *count);
+
+/**
+ * Look up a standard CRC model by name
+ *
+ * Both the names of the models and their common aliases are accepted, e.g.
+ * "CRC-32/ISCSI" or "CRC-32C". Names are compared case-insensitively.
+ *
+ * @param name  the name of the model
+ *
+ * @return the model or NULL if @p name is unknown
+ */
+const struct crcx_model *crcx_find_model(const char *name);
+
+/**
+ * Initialize a CRC context with the parameters of a standard model
+ *
+ * This is equivalent to calling @ref crcx_init with the parameters of the
+ * model returned by @ref crcx_find_model. The tables of a model are only
+ * generated once per process.
+ *
+ * @code{.c}
+ * struct crcx_ctx ctx;
+ * crcx_init_model(&ctx, "CRC-32C");
+ * @endcode
+ *
+ * @param ctx   the CRC context to initialize
+ * @param name  the name of the model
+ *
+ * @return true on success, or false if @p name is unknown
+ */
+bool crcx_init_model(struct crcx_ctx *ctx, const char *name);
+
+/**
+ * Verify a CRC model against its check value
+ *
+ * @param model  the model to verify
+ *
+ * @return true if the CRC of "123456789" equals @ref crcx_model.check
+ */
+bool crcx_check_model(const struct crcx_model *model);
+
 /**
  * Finalize a CRC context
  *
  * This function xor's the @ref crcx_ctx.fini value with the @ref crcx_ctx.lfsr.
  *
- * It also reflects the @ref crcx_ctx.lfsr if @ref crcx_ctx.reflect_output is
- * set.
+ * It also reflects the result if @ref crcx_ctx.reflect_output is set. Since
+ * the @ref crcx_ctx.lfsr of a context with @ref crcx_ctx.reflect_input set is
+ * already reflected, the result is only reflected when exactly one of the two
+ * is set.
  *
  * @param ctx  ctx the CRC context to initialize
  *
@@ -170,6 +413,30 @@ uintmax_t crcx_fini(struct crcx_ctx *ctx);
  */
 void crcx_update(struct crcx_ctx *ctx, uint8_t data);
 
+/**
+ * Update the CRC calculation with @p nbits bits of @p data
+ *
+ * This is useful for protocols whose CRC covers a number of bits that is not
+ * a multiple of 8, e.g. CAN frames or USB tokens. Whole bytes are processed
+ * like @ref crcx. The remaining @p nbits % 8 bits are taken from the
+ * following byte, starting from its most-significant bit, or from its
+ * least-significant bit if @ref crcx_ctx.reflect_input is set. The other bits
+ * of that byte are ignored.
+ *
+ * @code{.c}
+ * // CRC-5/USB of a token with address 0x15 and endpoint 0xe
+ * const uint8_t token[] = {0x15, 0x07};
+ * crcx_update_bits(&ctx, token, 11);
+ * @endcode
+ *
+ * @param ctx    the CRC context to update
+ * @param data   the data for which the CRC should be updated
+ * @param nbits  the number of bits of @p data to process
+ *
+ * @return true on success, otherwise false
+ */
+bool crcx_update_bits(struct crcx_ctx *ctx, const void *data, size_t nbits);
+
 /**
  * Compute the CRC
  *
@@ -177,8 +444,9 @@ void crcx_update(struct crcx_ctx *ctx, uint8_t data);
  * crcx_fini. Or, if performing multiple successive CRC calculations, it
  * can be called again after @ref crcx_fini.
  *
- * It validates input with @ref crcx_valid and then calls @ref crcx_update
- * @p len times, once for each item in @p data.
+ * The context is validated once by @ref crcx_init, which also binds it to an
+ * implementation (see @ref crcx_get_kernel). This function only checks that
+ * binding before processing @p data with it.
  *
  * Typical uses cases of CRCx will use this function along with @ref crcx_init
  * and @ref crcx_fini. However, doing so is simply a shorthand. It is entirely
@@ -196,6 +464,333 @@ void crcx_update(struct crcx_ctx *ctx, uint8_t data);
  */
 bool crcx(struct crcx_ctx *ctx, const void *data, const size_t len);
 
+/**
+ * Compute the CRC of scattered data
+ *
+ * This is equivalent to calling @ref crcx for each of the @p cnt segments in
+ * @p iov in turn, e.g. the fragments of a packet or the two halves of a
+ * wrapped ring buffer. Data is not copied, except that consecutive segments
+ * that are too short to benefit from the bound kernel are gathered into a
+ * small buffer.
+ *
+ * This function is not available on Windows.
+ *
+ * @param ctx  the CRC context to update
+ * @param iov  the segments of the data
+ * @param cnt  the number of elements of @p iov
+ *
+ * @return true on success, otherwise false
+ */
+bool crcx_v(struct crcx_ctx *ctx, const struct iovec *iov, int cnt);
+
+/**
+ * Update the CRC calculation with zeros
+ *
+ * This is equivalent to calling @ref crcx with @p len zero bytes, but takes
+ * O(log @p len) time using the operators in @ref crcx_ctx.zeros.
+ *
+ * @param ctx  the CRC context to update
+ * @param len  the number of zero bytes
+ *
+ * @return true on success, otherwise false
+ */
+bool crcx_zeros(struct crcx_ctx *ctx, uintmax_t len);
+
+/**
+ * Compute the CRC of a file
+ *
+ * Updates @p ctx with the contents of @p fd from offset 0 to the end of the
+ * file. Regular files are mapped into memory with sequential access hints,
+ * or read in large blocks if they cannot be mapped. On file systems that
+ * support SEEK_DATA and SEEK_HOLE, holes in sparse files are not read but
+ * accounted for with @ref crcx_zeros. The file must not be truncated while it
+ * is mapped, otherwise the process receives SIGBUS.
+ *
+ * Pipes, sockets, character devices and files whose size is unknown, e.g. in
+ * procfs, are read from their current offset until the end of the file. The
+ * file offset of @p fd is undefined on return.
+ *
+ * @param ctx  the CRC context to update
+ * @param fd   a file descriptor open for reading
+ *
+ * @return true on success, otherwise false with errno set
+ */
+bool crcx_fd(struct crcx_ctx *ctx, int fd);
+
+/**
+ * Compute the CRC of the file at @p path
+ *
+ * This opens @p path for reading and calls @ref crcx_fd.
+ *
+ * @code{.c}
+ * struct crcx_ctx ctx;
+ * crcx_init_model(&ctx, "CRC-32C");
+ * if (crcx_file(&ctx, "/var/lib/image.bin")) {
+ *   printf("%08jx\n", crcx_fini(&ctx));
+ * }
+ * @endcode
+ *
+ * @param ctx   the CRC context to update
+ * @param path  the path of the file
+ *
+ * @return true on success, otherwise false with errno set
+ */
+bool crcx_file(struct crcx_ctx *ctx, const char *path);
+
+/**
+ * Compute the CRCs of many files
+ *
+ * This is intended for checksumming a large number of files, e.g. on NVMe
+ * drives, where a loop around @ref crcx_file cannot keep enough reads in
+ * flight to saturate the device.
+ *
+ * With io_uring, the calling thread keeps up to @p depth reads outstanding,
+ * spread over as many files as it takes, and computes the CRCs as the reads
+ * complete, in any order. This needs Linux 5.6 or later, or Linux 5.1 if the
+ * read buffers can be registered within RLIMIT_MEMLOCK, and io_uring not to be
+ * disabled, e.g. by seccomp or kernel.io_uring_disabled. Otherwise, up to
+ * @p depth threads each compute the CRCs of whole files. Pipes and files whose
+ * size is unknown, e.g. in procfs, are read until the end.
+ *
+ * @code{.c}
+ * const char *paths[] = {"a.bin", "b.bin", "c.bin"};
+ * uintmax_t crcs[3];
+ * int errors[3];
+ * crcx_files(&ctx, paths, 3, crcs, errors, 0, CRCX_IO_AUTO);
+ * @endcode
+ *
+ * @param ctx     the CRC context to use, which is not modified
+ * @param paths   the paths of the files
+ * @param count   the number of elements of @p paths
+ * @param crcs    where to store the CRC of each file, or -1 on error
+ * @param errors  where to store 0 or the errno of each file, or NULL
+ * @param depth   the number of reads or threads in flight, or 0 for a default
+ * @param io      the I/O engine to use
+ *
+ * @return true if the CRC of every file was computed, otherwise false with
+ *         errno set, e.g. to the error of the first file that failed or to
+ *         ENOSYS if @p io is not available
+ */
+bool crcx_files(const struct crcx_ctx *ctx, const char *const *paths,
+                size_t count, uintmax_t *crcs, int *errors, unsigned depth,
+                enum crcx_io io);
+
+/**
+ * Compute the CRC using multiple threads
+ *
+ * This is equivalent to @ref crcx, but @p data is split into contiguous
+ * chunks that are processed concurrently, and the partial results are merged
+ * as in @ref crcx_combine. It is intended for large buffers. Fewer threads
+ * are used if the chunks would be too small to benefit, and @p data is
+ * processed by the calling thread alone if that leaves only one.
+ *
+ * @p ctx is only read by the worker threads and must not be modified
+ * until this function returns.
+ *
+ * @param ctx      the CRC context to use
+ * @param data     the data for which the CRC should be calculated
+ * @param len      the length of @p data
+ * @param threads  the maximum number of threads, including the calling
+ *                 thread, or 0 to use one per online CPU
+ *
+ * @return true on success, otherwise false
+ */
+bool crcx_parallel(struct crcx_ctx *ctx, const void *data, const size_t len,
+                   unsigned threads);
+
+/**
+ * Combine the CRCs of two consecutive segments
+ *
+ * Given the CRC of a segment A and the CRC of a segment B, both computed from
+ * scratch with the same parameters as @p ctx, this function computes the CRC
+ * of A followed by B in O(log @p len2) time without accessing the data. This
+ * allows segments to be processed independently, e.g. on different cores.
+ *
+ * @ref crcx_ctx.init, @ref crcx_ctx.fini and the reflection flags are
+ * accounted for. @p ctx is not modified.
+ *
+ * @param ctx   the CRC context, which must have been initialized with
+ *              @ref crcx_init
+ * @param crc1  the result of @ref crcx_fini for segment A
+ * @param crc2  the result of @ref crcx_fini for segment B
+ * @param len2  the length of segment B in bytes
+ *
+ * @return the CRC of A followed by B, or -1 on error
+ */
+uintmax_t crcx_combine(const struct crcx_ctx *ctx, uintmax_t crc1,
+                       uintmax_t crc2, uintmax_t len2);
+
+/**
+ * Get the implementation that a CRC context is bound to
+ *
+ * @ref crcx_init selects, in order of preference, @ref CRCX_KERNEL_CRC32C
+ * for CRC-32C on CPUs with SSE4.2, @ref CRCX_KERNEL_CLMUL on CPUs with
+ * PCLMULQDQ, and otherwise @ref CRCX_KERNEL_TABLE.
+ * @ref crcx_generate_slices upgrades @ref CRCX_KERNEL_TABLE to
+ * @ref CRCX_KERNEL_SLICING.
+ *
+ * @param ctx  the CRC context
+ *
+ * @return the kernel in use or @ref CRCX_KERNEL_NONE if @p ctx is not
+ * initialized
+ */
+enum crcx_kernel crcx_get_kernel(const struct crcx_ctx *ctx);
+
+/**
+ * Bind a CRC context to a specific implementation
+ *
+ * All implementations produce identical results. This is mainly useful to
+ * compare or benchmark them.
+ *
+ * @param ctx     the CRC context, which must have been initialized with
+ *                @ref crcx_init
+ * @param kernel  the desired implementation
+ *
+ * @return true on success, or false if @p kernel is not available for
+ * @p ctx on this CPU
+ */
+bool crcx_set_kernel(struct crcx_ctx *ctx, enum crcx_kernel kernel);
+
+/**
+ * Initialize a CRC stream
+ *
+ * @param stream  the stream to initialize
+ * @param ctx     the CRC context to share, which must have been initialized
+ *                with @ref crcx_init
+ *
+ * @return true on success, otherwise false
+ */
+bool crcx_stream_init(struct crcx_stream *stream, const struct crcx_ctx *ctx);
+
+/**
+ * Update a CRC stream with new @p data
+ *
+ * This is the equivalent of @ref crcx for streams.
+ *
+ * @param stream  the stream to update
+ * @param data    the data for which the CRC should be calculated
+ * @param len     the length of @p data
+ *
+ * @return true on success, otherwise false
+ */
+bool crcx_stream_update(struct crcx_stream *stream, const void *data,
+                        const size_t len);
+
+/**
+ * Finalize a CRC stream
+ *
+ * This is the equivalent of @ref crcx_fini for streams. Afterwards, @p stream
+ * may be used for a new calculation.
+ *
+ * @param stream  the stream to finalize
+ *
+ * @return the result of the CRC calculation or -1 on error
+ */
+uintmax_t crcx_stream_fini(struct crcx_stream *stream);
+
+/**
+ * Update many CRC streams, each with a message of its own
+ *
+ * This is faster than calling @ref crcx_stream_update for each message when
+ * the messages are short, e.g. network packets. Consecutive messages whose
+ * streams share a context that processes them a byte at a time, i.e. with
+ * @ref CRCX_KERNEL_TABLE or with @ref CRCX_KERNEL_CLMUL for messages shorter
+ * than 64 bytes, are processed several at a time in lockstep, so that their
+ * table lookups overlap. Messages of different lengths are fine.
+ * Other messages are processed one at a time with the kernel bound to their
+ * context.
+ *
+ * Each stream must appear at most once in a batch.
+ *
+ * @code{.c}
+ * struct crcx_stream streams[N];
+ * struct crcx_msg msgs[N];
+ * uintmax_t crcs[N];
+ * for (size_t i = 0; i < N; ++i) {
+ *   crcx_stream_init(&streams[i], &ctx);
+ *   msgs[i] = (struct crcx_msg){&streams[i], packet[i], packet_len[i]};
+ * }
+ * crcx_batch(msgs, N, crcs);
+ * @endcode
+ *
+ * @param msgs   the messages
+ * @param count  the number of elements of @p msgs
+ * @param crcs   where to store the result of @ref crcx_stream_fini for each
+ *               stream, or NULL to leave the streams open
+ *
+ * @return true on success, or false if any message is invalid, in which case
+ *         no stream is updated
+ */
+bool crcx_batch(struct crcx_msg *msgs, size_t count, uintmax_t *crcs);
+
+/**
+ * Initialize a pool of CRC streams
+ *
+ * @code{.c}
+ * static struct crcx_stream streams[1024];
+ * struct crcx_pool pool;
+ * crcx_pool_init(&pool, streams, ARRAY_SIZE(streams));
+ * @endcode
+ *
+ * @param pool      the pool to initialize
+ * @param streams   storage for @p capacity streams
+ * @param capacity  the maximum number of streams in use at a time
+ *
+ * @return true on success, otherwise false
+ */
+bool crcx_pool_init(struct crcx_pool *pool, struct crcx_stream *streams,
+                    size_t capacity);
+
+/**
+ * Get a stream from a pool
+ *
+ * The stream is initialized with @ref crcx_stream_init.
+ *
+ * @param pool  the pool to allocate from
+ * @param ctx   the CRC context to share
+ *
+ * @return a stream, or NULL if the pool is exhausted or @p ctx is not
+ * initialized
+ */
+struct crcx_stream *crcx_pool_get(struct crcx_pool *pool,
+                                  const struct crcx_ctx *ctx);
+
+/**
+ * Return a stream to a pool
+ *
+ * @param pool    the pool that @p stream was allocated from
+ * @param stream  the stream to return
+ *
+ * A stream that was put back must not be used until it is handed out again.
+ * Streams that were put back are rejected by @ref crcx_stream_update,
+ * @ref crcx_stream_fini, @ref crcx_batch and by this function, so that
+ * putting a stream back twice does not corrupt the pool.
+ *
+ * @return true on success, or false if @p stream is not in use in @p pool
+ */
+bool crcx_pool_put(struct crcx_pool *pool, struct crcx_stream *stream);
+
+/**
+ * Get statistics of the process-wide table cache
+ *
+ * The table and the other data derived from @ref crcx_ctx.n,
+ * @ref crcx_ctx.poly and @ref crcx_ctx.reflect_input are generated once per
+ * process by @ref crcx_init and copied from a cache afterwards. Lookups are
+ * lock-free and the cache may be used from any thread.
+ *
+ * @param stats  where to store the statistics
+ */
+void crcx_get_cache_stats(struct crcx_cache_stats *stats);
+
+/**
+ * Get the name of an implementation
+ *
+ * @param kernel  the implementation
+ *
+ * @return a human readable name of @p kernel, e.g. "clmul"
+ */
+const char *crcx_kernel_name(enum crcx_kernel kernel);
+
 __END_DECLS
 
 #endif /* CRCX_H_ */
@@ -1,3 +1,8 @@
+#include <array>
+#include <list>
+#include <random>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -468,3 +473,318 @@ TEST(LibCRC3x, rfc1662_fcs16) {
 
   EXPECT_EQ(actual, expected) << "HDLC check failed";
 }
+
+// this test shows that slicing-by-8/16 gives the same result as byte-wise
+template <typename T, size_t N, T polynomial>
+static void check_slicing(T init, T fini, bool reflectInput,
+                          bool reflectOutput) {
+  using Crc3x = Crc<T, N, polynomial>;
+
+  ASSERT_EQ(Crc3x::slices[0], Crc3x::table)
+      << "The first slicing table is incorrect";
+
+  Crc3x expected_crc(init, fini, reflectInput, reflectOutput);
+  Crc3x actual_crc(init, fini, reflectInput, reflectOutput);
+
+  for (size_t len = 0; len < 100; ++len) {
+    vector<uint8_t> data(len);
+    mt19937 gen(len);
+    for (auto &d : data) {
+      d = uint8_t(gen());
+    }
+
+    for (auto &d : data) {
+      expected_crc.update(d);
+    }
+    actual_crc.update(data.data(), data.data() + data.size());
+
+    auto expected = expected_crc.fini();
+    auto actual = actual_crc.fini();
+    ASSERT_EQ(actual, expected) << "N: " << N << " len: " << len;
+  }
+}
+
+TEST(LibCRC3x, slicing) {
+  check_slicing<uint8_t, 8, 0x07>(0, 0, false, false);
+  check_slicing<uint8_t, 8, 0x39>(0, 0, true, true);
+  check_slicing<uint16_t, 16, 0x1021>(0, 0, false, false);
+  check_slicing<uint32_t, 24, 0x00065b>(0x555555, 0, true, false);
+  check_slicing<uint32_t, 32, 0x4c11db7>(0, -1, false, false);
+  check_slicing<uint64_t, 64, 0x42F0E1EBA9EA3693>(0, 0, false, false);
+  check_slicing<uint64_t, 64, 0x42F0E1EBA9EA3693>(-1, -1, true, true);
+}
+
+// this test shows that CRCs that are not a multiple of 8 bits in length give
+// the standard check values for the string "123456789"
+template <typename T, size_t N, T polynomial>
+static void check_width(T init, T fini, bool reflectInput, bool reflectOutput,
+                        T expected) {
+  const string msg = "123456789";
+  Crc<T, N, polynomial> crc(init, fini, reflectInput, reflectOutput);
+
+  for (auto &c : msg) {
+    crc.update(uint8_t(c));
+  }
+  EXPECT_EQ(crc.fini(), expected) << "N: " << N;
+
+  crc.update(msg.data(), msg.data() + msg.size());
+  EXPECT_EQ(crc.fini(), expected) << "N: " << N;
+}
+
+TEST(LibCRC3x, arbitrary_width) {
+  // CRC-3/GSM, CRC-5/USB, CRC-7/MMC
+  check_width<uint8_t, 3, 0x3>(0, 0x7, false, false, 0x4);
+  check_width<uint8_t, 5, 0x05>(0x1f, 0x1f, true, true, 0x19);
+  check_width<uint8_t, 7, 0x09>(0, 0, false, false, 0x75);
+  // CRC-10/ATM, CRC-12/UMTS, CRC-15/CAN
+  check_width<uint16_t, 10, 0x233>(0, 0, false, false, 0x199);
+  check_width<uint16_t, 12, 0x80f>(0, 0, false, true, 0xdaf);
+  check_width<uint16_t, 15, 0x4599>(0, 0, false, false, 0x59e);
+  // CRC-31/PHILIPS, CRC-40/GSM
+  check_width<uint32_t, 31, 0x4c11db7>(0x7fffffff, 0x7fffffff, false, false,
+                                       0xce9e46c);
+  check_width<uint64_t, 40, 0x4820009>(0, 0xffffffffff, false, false,
+                                       0xd4164fc646);
+
+  check_slicing<uint8_t, 5, 0x05>(0x1f, 0x1f, true, true);
+  check_slicing<uint16_t, 12, 0x80f>(0, 0, false, true);
+  check_slicing<uint32_t, 31, 0x4c11db7>(0x7fffffff, 0x7fffffff, false, false);
+  check_slicing<uint64_t, 40, 0x4820009>(0, 0xffffffffff, false, false);
+}
+
+// this test shows that updating a whole number of bytes bit-wise gives the
+// same result as byte-wise, and that partial bytes give the standard result
+template <typename T, size_t N, T polynomial>
+static void check_bits(T init, T fini, bool reflectInput, bool reflectOutput) {
+  Crc<T, N, polynomial> expected_crc(init, fini, reflectInput, reflectOutput);
+  Crc<T, N, polynomial> actual_crc(init, fini, reflectInput, reflectOutput);
+
+  vector<uint8_t> data(20);
+  mt19937 gen(data.size());
+  for (auto &d : data) {
+    d = uint8_t(gen());
+  }
+
+  for (size_t len = 0; len <= data.size(); ++len) {
+    expected_crc.update(data.data(), data.data() + len);
+    actual_crc.update_bits(data.data(), 8 * len);
+    ASSERT_EQ(actual_crc.fini(), expected_crc.fini())
+        << "N: " << N << " len: " << len;
+  }
+}
+
+TEST(LibCRC3x, update_bits) {
+  check_bits<uint8_t, 5, 0x05>(0x1f, 0x1f, true, true);
+  check_bits<uint16_t, 15, 0x4599>(0, 0, false, false);
+  check_bits<uint32_t, 32, 0x4c11db7>(-1, -1, true, true);
+  check_bits<uint64_t, 64, 0x42F0E1EBA9EA3693>(0, 0, false, false);
+
+  // CRC-5/USB of a token with address 0x15 and endpoint 0xe
+  Crc<uint8_t, 5, 0x05> usb(0x1f, 0x1f, true, true);
+  const uint8_t token[] = {0x15, 0x07};
+  usb.update_bits(token, 11);
+  EXPECT_EQ(usb.fini(), 0x1d);
+
+  // CRC-15/CAN of the 19 bits 0b1000'0000'0000'0000'010
+  Crc<uint16_t, 15, 0x4599> can(0, 0, false, false);
+  const uint8_t frame[] = {0x80, 0x00, 0x40};
+  can.update_bits(frame, 19);
+  EXPECT_EQ(can.fini(), 0x5c9);
+}
+
+// this test shows that a sequence of segments gives the same result as
+// contiguous data
+TEST(LibCRC3x, segments) {
+  using Crc3x = Crc<uint32_t, 32, 0x4c11db7>;
+  Crc3x crc(-1, -1, true, true);
+
+  const vector<string_view> check = {"", "1", "23", "", "456789"};
+  crc.update(check);
+  EXPECT_EQ(crc.fini(), 0xcbf43926);
+
+  vector<uint8_t> data(1000);
+  mt19937 gen(data.size());
+  for (auto &d : data) {
+    d = uint8_t(gen());
+  }
+  crc.update(data.data(), data.data() + data.size());
+  const auto expected = crc.fini();
+
+  vector<vector<uint8_t>> segments;
+  for (size_t off = 0; off < data.size();) {
+    size_t len = min<size_t>(gen() % 40, data.size() - off);
+    segments.emplace_back(data.begin() + off, data.begin() + off + len);
+    off += len;
+  }
+  crc.update(segments);
+  EXPECT_EQ(crc.fini(), expected);
+}
+
+// this test shows that contiguous ranges and iterators over them give the
+// same result as one byte at a time
+template <typename T, size_t N, T polynomial>
+static void check_contiguous(T init, T fini, bool refin, bool refout) {
+  using Crc3x = Crc<T, N, polynomial>;
+  Crc3x crc(init, fini, refin, refout);
+
+  string data(1000, '\0');
+  mt19937 gen(data.size());
+  for (auto &d : data) {
+    d = char(gen());
+  }
+
+  for (size_t len : {0, 1, 7, 8, 15, 16, 17, 100, 1000}) {
+    const string s = data.substr(0, len);
+    const vector<uint8_t> v(s.begin(), s.end());
+    const list<uint8_t> l(s.begin(), s.end());
+
+    for (auto c : s) {
+      crc.update(uint8_t(c));
+    }
+    const auto expected = crc.fini();
+
+    crc.update(s.data(), s.size());
+    EXPECT_EQ(crc.fini(), expected) << "pointer and length " << len;
+    crc.update(string_view(s));
+    EXPECT_EQ(crc.fini(), expected) << "string_view " << len;
+    crc.update(s);
+    EXPECT_EQ(crc.fini(), expected) << "string " << len;
+    crc.update(s.begin(), s.end());
+    EXPECT_EQ(crc.fini(), expected) << "string iterators " << len;
+    crc.update(v);
+    EXPECT_EQ(crc.fini(), expected) << "vector " << len;
+    crc.update(v.cbegin(), v.cend());
+    EXPECT_EQ(crc.fini(), expected) << "vector iterators " << len;
+    crc.update(l.begin(), l.end());
+    EXPECT_EQ(crc.fini(), expected) << "list iterators " << len;
+  }
+
+  // string literals exclude the terminating NUL, arrays of uint8_t do not
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  crc.update(check);
+  const auto expected = crc.fini();
+  crc.update("123456789");
+  EXPECT_EQ(crc.fini(), expected);
+  crc.update(array<uint8_t, 9>{'1', '2', '3', '4', '5', '6', '7', '8', '9'});
+  EXPECT_EQ(crc.fini(), expected);
+}
+
+TEST(LibCRC3x, contiguous) {
+  check_contiguous<uint8_t, 8, 0x07>(0, 0, false, false);
+  check_contiguous<uint16_t, 16, 0x1021>(0xffff, 0, true, true);
+  check_contiguous<uint32_t, 24, 0x65b>(0x555555, 0, true, true);
+  check_contiguous<uint32_t, 32, 0x4c11db7>(-1, -1, true, true);
+  check_contiguous<uint64_t, 64, 0x42F0E1EBA9EA3693>(0, 0, false, false);
+  check_contiguous<uint16_t, 15, 0x4599>(0, 0, false, false);
+
+  Crc<uint32_t, 32, 0x4c11db7> crc(-1, -1, true, true);
+  crc.update("123456789");
+  EXPECT_EQ(crc.fini(), 0xcbf43926);
+}
+
+// this test shows that CRCs can be computed at compile time
+TEST(LibCRC3x, constant_expressions) {
+  // https://reveng.sourceforge.io/crc-catalogue/
+  static_assert(compute<models::crc8_smbus>("123456789") == 0xf4);
+  static_assert(compute<models::crc16_xmodem>("123456789") == 0x31c3);
+  static_assert(compute<models::crc16_kermit>("123456789") == 0x2189);
+  static_assert(compute<models::crc16_ibm_sdlc>("123456789") == 0x906e);
+  static_assert(compute<models::crc24_ble>("123456789") == 0xc25a56);
+  static_assert(compute<models::crc32_iso_hdlc>("123456789") == 0xcbf43926);
+  static_assert(compute<models::crc32_cksum>("123456789") == 0x765e7680);
+  static_assert(compute<models::crc32_iscsi>("123456789") == 0xe3069283);
+  static_assert(compute<models::crc64_ecma_182>("123456789") ==
+                0x6c40df5f0b497347);
+  static_assert(compute<models::crc64_xz>("123456789") == 0x995dc9bbdf1939fa);
+
+  // longer than one slicing-by-16 block, as bytes, iterators and segments
+  constexpr array<uint8_t, 20> bytes{'1', '2', '3', '4', '5', '6', '7',
+                                     '8', '9', '0', '1', '2', '3', '4',
+                                     '5', '6', '7', '8', '9', '0'};
+  constexpr array<string_view, 3> segments{"1234567890", "", "1234567890"};
+  constexpr auto crc = compute<models::crc32_iso_hdlc>(bytes);
+  static_assert(compute<models::crc32_iso_hdlc>("12345678901234567890") ==
+                crc);
+  static_assert(compute<models::crc32_iso_hdlc>(bytes.begin(), bytes.end()) ==
+                crc);
+  static_assert(compute<models::crc32_iso_hdlc>(segments) == crc);
+
+  // a Crc object, updated piecewise and with a partial byte
+  constexpr auto usb = [] {
+    Crc<uint8_t, 5, 0x05> crc(0x1f, 0x1f, true, true);
+    const uint8_t token[] = {0x15, 0x07};
+    crc.update_bits(token, 11);
+    return crc.fini();
+  }();
+  static_assert(usb == 0x1d);
+
+  // the same results at runtime
+  auto c = models::crc32_iso_hdlc::crc();
+  c.update(string("12345678901234567890"));
+  EXPECT_EQ(c.fini(), crc);
+  const vector<uint8_t> v(bytes.begin(), bytes.end());
+  EXPECT_EQ(compute<models::crc32_iso_hdlc>(v.data(), v.size()), crc);
+}
+
+// this test shows that a ModelCrc gives the same results as a Crc with the
+// same parameters
+template <typename T, size_t N, T polynomial, T init, T fini, bool refin,
+          bool refout>
+static void check_model() {
+  using M = Model<T, N, polynomial, init, fini, refin, refout>;
+  Crc<T, N, polynomial> expected(init, fini, refin, refout);
+  ModelCrc<M> actual;
+
+  vector<uint8_t> data(1000);
+  mt19937 gen(N);
+  for (auto &d : data) {
+    d = uint8_t(gen());
+  }
+
+  for (size_t len : {0, 1, 7, 8, 9, 15, 16, 17, 31, 33, 1000}) {
+    expected.update(data.begin(), data.begin() + len);
+    actual.update(data.begin(), data.begin() + len);
+    EXPECT_EQ(actual.fini(), expected.fini()) << "N " << N << " len " << len;
+  }
+
+  for (size_t nbits = 0; nbits < 40; ++nbits) {
+    expected.update_bits(data.data(), nbits);
+    actual.update_bits(data.data(), nbits);
+    EXPECT_EQ(actual.fini(), expected.fini())
+        << "N " << N << " nbits " << nbits;
+  }
+
+  // byte at a time
+  for (auto d : data) {
+    expected.update(d);
+    actual.update(d);
+  }
+  EXPECT_EQ(actual.fini(), expected.fini()) << "N " << N;
+}
+
+TEST(LibCRC3x, model_policies) {
+  check_model<uint8_t, 3, 0x3, 0x7, 0, true, true>();
+  check_model<uint8_t, 5, 0x05, 0x1f, 0x1f, true, true>();
+  check_model<uint8_t, 7, 0x09, 0, 0, false, false>();
+  check_model<uint8_t, 8, 0x07, 0, 0x55, false, false>();
+  check_model<uint8_t, 8, 0x39, 0, 0, true, true>();
+  check_model<uint16_t, 12, 0x80f, 0, 0, false, true>();
+  check_model<uint16_t, 12, 0x80f, 0xabc, 0x123, true, false>();
+  check_model<uint16_t, 15, 0x4599, 0, 0, false, false>();
+  check_model<uint16_t, 16, 0x1021, 0xffff, 0xffff, true, true>();
+  check_model<uint32_t, 24, 0x65b, 0x555555, 0, true, true>();
+  check_model<uint32_t, 31, 0x4c11db7, 0x7fffffff, 0x7fffffff, false, false>();
+  check_model<uint32_t, 32, 0x1edc6f41, 0xffffffff, 0xffffffff, true, true>();
+  check_model<uint64_t, 40, 0x0004820009, 0, 0xffffffffff, false, false>();
+  check_model<uint64_t, 64, 0x42f0e1eba9ea3693, ~0ULL, ~0ULL, true, true>();
+
+  // https://reveng.sourceforge.io/crc-catalogue/
+  using crc5_usb = Model<uint8_t, 5, 0x05, 0x1f, 0x1f, true, true>;
+  using crc12_umts = Model<uint16_t, 12, 0x80f, 0, 0, false, true>;
+  using crc40_gsm =
+      Model<uint64_t, 40, 0x0004820009, 0, 0xffffffffff, false, false>;
+  static_assert(compute<crc5_usb>("123456789") == 0x19);
+  static_assert(compute<crc12_umts>("123456789") == 0xdaf);
+  static_assert(compute<crc40_gsm>("123456789") == 0xd4164fc646);
+  static_assert(sizeof(ModelCrc<crc40_gsm>) == sizeof(uint64_t));
+}
@@ -24,7 +24,14 @@
 
 #include <algorithm>
 #include <bitset>
+#include <cerrno>
 #include <cstdlib>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
 #include <gtest/gtest.h>
 
@@ -64,7 +71,8 @@ static vector<uintmax_t> to_vector(string s) {
   return r;
 }
 
-static vector<uintmax_t> to_vector(uintmax_t *x, size_t len) {
+template <typename T>
+static vector<uintmax_t> to_vector(const T *x, size_t len) {
   return vector<uintmax_t>(x, x + len);
 }
 
@@ -84,8 +92,15 @@ TEST(Sanity, poly_zero) {
       .msb = 1 << (8 - 1),
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
   ASSERT_FALSE(::crcx_valid(&ctx));
 }
@@ -100,8 +115,15 @@ TEST(Sanity, poly_highest_bit_greater_than_n) {
       .msb = 1 << (8 - 1),
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
   ASSERT_FALSE(::crcx_valid(&ctx));
 }
@@ -116,26 +138,40 @@ TEST(Sanity, n_zero) {
       .msb = 1 << (8 - 1),
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
   ASSERT_FALSE(::crcx_valid(&ctx));
 }
 
 TEST(Sanity, n_not_a_multiple_of_8) {
   ::crcx_ctx ctx = {
-      .n = 7, // number of bits must be a non-zero and positive multiple of 8
+      .n = 7, // any number of bits from 1 to 64 is valid
       .init = 0,
       .fini = 0,
-      .poly = 0x7,
-      .mask = (1 << 8) - 1,
-      .msb = 1 << (8 - 1),
+      .poly = 0x9,
+      .mask = (1 << 7) - 1,
+      .msb = 1 << (7 - 1),
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
-  ASSERT_FALSE(::crcx_valid(&ctx));
+  ASSERT_TRUE(::crcx_valid(&ctx));
 }
 
 TEST(Sanity, n_greater_than_sizeof_uintmax) {
@@ -149,8 +185,15 @@ TEST(Sanity, n_greater_than_sizeof_uintmax) {
       .msb = 1 << (8 - 1),
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
   ASSERT_FALSE(::crcx_valid(&ctx));
 }
@@ -165,8 +208,15 @@ TEST(Sanity, msb_invalid) {
       .msb = 0x1, // msb must be 1 << (n - 1)
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
   ASSERT_FALSE(::crcx_valid(&ctx));
 }
@@ -181,8 +231,15 @@ TEST(Sanity, mask_invalid) {
       .msb = 1 << (8 - 1),
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
   ASSERT_FALSE(::crcx_valid(&ctx));
 }
@@ -197,8 +254,15 @@ TEST(Sanity, mask_invalid64) {
       .msb = 0x8000000000000000ULL,
       .reflect_input = false,
       .reflect_output = false,
-      .table = {},
       .lfsr = 0,
+      .kernel = CRCX_KERNEL_NONE,
+      .update = nullptr,
+      .slices = 0,
+      .slice = nullptr,
+      .clmul = false,
+      .table8 = {},
+      .fold = {},
+      .zeros = {},
   };
   ASSERT_FALSE(::crcx_valid(&ctx));
 }
@@ -266,7 +330,7 @@ TEST(LibCRCx, Wikipedia_example1) {
     "0xDE 0xD9 0xD0 0xD7 0xC2 0xC5 0xCC 0xCB 0xE6 0xE1 0xE8 0xEF 0xFA 0xFD 0xF4 0xF3 "
   );
   // clang-format on
-  auto actual_v = to_vector((uintmax_t *)ctx.table, ARRAY_SIZE(ctx.table));
+  auto actual_v = to_vector(ctx.table8, ARRAY_SIZE(ctx.table8));
 
   ASSERT_EQ(actual_v, expected_v) << "The generated table is incorrect";
 
@@ -401,7 +465,7 @@ TEST(LibCRCx, Sunshine_CRC16_CCIT_ZERO_one_byte) {
         "0xEF1F 0xFF3E 0xCF5D 0xDF7C 0xAF9B 0xBFBA 0x8FD9 0x9FF8 0x6E17 0x7E36 0x4E55 0x5E74 0x2E93 0x3EB2 0x0ED1 0x1EF0 "
     );
   // clang-format on
-  auto actual_v = to_vector((uintmax_t *)ctx.table, ARRAY_SIZE(ctx.table));
+  auto actual_v = to_vector(ctx.table16, ARRAY_SIZE(ctx.table16));
 
   ASSERT_EQ(actual_v, expected_v) << "The generated table is incorrect";
 
@@ -492,7 +556,7 @@ TEST(LibCRCx, Sunshine_CRC16_CCIT_ZERO) {
         "0xEF1F 0xFF3E 0xCF5D 0xDF7C 0xAF9B 0xBFBA 0x8FD9 0x9FF8 0x6E17 0x7E36 0x4E55 0x5E74 0x2E93 0x3EB2 0x0ED1 0x1EF0 "
     );
   // clang-format on
-  auto actual_v = to_vector((uintmax_t *)ctx.table, ARRAY_SIZE(ctx.table));
+  auto actual_v = to_vector(ctx.table16, ARRAY_SIZE(ctx.table16));
 
   ASSERT_EQ(actual_v, expected_v) << "The generated table is incorrect";
 
@@ -558,7 +622,7 @@ TEST(LibCRCx, Sunshine_CRC32_POSIX) {
         "0xAFB010B1 0xAB710D06 0xA6322BDF 0xA2F33668 0xBCB4666D 0xB8757BDA 0xB5365D03 0xB1F740B4 "
     );
   // clang-format on
-  auto actual_v = to_vector((uintmax_t *)ctx.table, ARRAY_SIZE(ctx.table));
+  auto actual_v = to_vector(ctx.table32, ARRAY_SIZE(ctx.table32));
 
   ASSERT_EQ(actual_v, expected_v) << "The generated table is incorrect";
 
@@ -624,7 +688,7 @@ TEST(LibCRCx, Sunshine_CRC64_ECMA_182) {
         "0x14DEA25F3AF9026D 0x562E43B4931334FE 0x913F6188692D6F4B 0xD3CF8063C0C759D8 0x5DEDC41A34BBEEB2 0x1F1D25F19D51D821 0xD80C07CD676F8394 0x9AFCE626CE85B507 "
     );
   // clang-format on
-  auto actual_v = to_vector((uintmax_t *)ctx.table, ARRAY_SIZE(ctx.table));
+  auto actual_v = to_vector(ctx.table64, ARRAY_SIZE(ctx.table64));
 
   ASSERT_EQ(actual_v, expected_v) << "The generated table is incorrect";
 
@@ -646,6 +710,17 @@ TEST(LibCRCx, reflect24) {
       << "actual:   " << hex << setw(6) << setfill('0') << actual_uintmax;
 }
 
+TEST(LibCRCx, reflect) {
+  const uintmax_t x = 0x0123456789abcdef;
+  for (uint8_t n = 1; n <= 64; ++n) {
+    uintmax_t expected_uintmax = 0;
+    for (uint8_t i = 0; i < n; ++i) {
+      expected_uintmax |= ((x >> i) & 1) << (n - 1 - i);
+    }
+    EXPECT_EQ(::crcx_reflect(x, n), expected_uintmax) << "n: " << unsigned(n);
+  }
+}
+
 // BLE CRC polynomial is  x^24 + x^10 + x^9 + x^6 + x^4 + x^3 + x + 1
 // This corresponds to 0x[1]00065b
 // In the advertising channel, the BLE CRC initializer is 0x555555
@@ -814,19 +889,16 @@ TEST(LibCRCx, ble_core_52_4_2_1_Legacy_Advertising_PDUs) {
 // The table in rfc1662 is "reflected", using the terminology of 
 // http://www.sunshine2k.de/coding/javascript/crc/crc_js.html
 
-// Currently, CRCx does not use reflected tables
-// It is likely far more computationally efficient to do so when bits should be processed MSB first.
+// CRCx uses reflected tables when the input is reflected. That is an optimization that avoids having
+// to reflect input bits and reflect output bits.
 
-// At risk of generalizing, it would seem to be the case that using "reflected tables" is an optimization
-// that avoids having to reflect input bits and reflect output bits.
-
-// A side effect of not using reflected tables seems to be that the check at the end becoes zero
-// instead of 0xf0b8.
+// With fini = 0, the check at the end is zero. The RFC uses a final xor of 0xffff, so the FCS is
+// complemented, and the check is then 0xf0b8 before the final xor, or 0x0f47 after it.
 
 constexpr size_t hdlc_crc_n = 16;
 constexpr uintmax_t hdlc_poly = 0x1021;
 constexpr uintmax_t hdlc_init = 0xffff;
-constexpr uintmax_t hdlc_check = 0; // 0xf0b8 <-- only when using "reflected tables"
+constexpr uintmax_t hdlc_check = 0; // 0xf0b8 <-- before xorout, only when fini = 0xffff
 constexpr uintmax_t hdlc_fini = 0;
 constexpr bool hdlc_reflect_input = true;
 constexpr bool hdlc_reflect_output = true;
@@ -871,9 +943,9 @@ TEST(LibCRCx, hdlc_fcs16_table) {
   ASSERT_TRUE(::crcx_init(&ctx, hdlc_crc_n, hdlc_poly, hdlc_init, hdlc_fini,
                           hdlc_reflect_input, hdlc_reflect_output));
 
-  vector<uintmax_t> actual_table(&ctx.table[0], &ctx.table[256]);
+  vector<uintmax_t> actual_table(&ctx.table16[0], &ctx.table16[256]);
 
-  EXPECT_NE(expected_table, actual_table);
+  EXPECT_EQ(expected_table, actual_table);
 }
 
 TEST(LibCRCx, rfc1662_fcs16) {
@@ -909,8 +981,8 @@ TEST(LibCRCx, rfc1662_fcs16) {
 
   ASSERT_TRUE(::crcx(&ctx, &data.front(), data.size()));
 
-  // a side-effect of *not* using "reflected tables" is that input & output must be reflected
-  // which is computationally expensive, and also that the check at the end is no longer 0xf0b8 but 0.
+  // with fini = 0 the FCS is not complemented, so the check at the end is 0
+  // rather than the RFC's 0xf0b8 residue
 
   expected_uintmax = hdlc_check;
   actual_uintmax = ::crcx_fini(&ctx);
@@ -920,3 +992,751 @@ TEST(LibCRCx, rfc1662_fcs16) {
       << " "
       << "actual: " << hex << setw(4) << setfill('0') << actual_uintmax << " ";
 }
+
+// CRC-8, CRC-16/CCITT, CRC-24/BLE, CRC-32/POSIX, CRC-64/ECMA-182, a couple
+// of reflected models and some widths that are not a multiple of 8 (CRC-5/USB,
+// CRC-12/UMTS, CRC-15/CAN, CRC-31/PHILIPS). Each tuple is (n, poly, init,
+// fini, refin, refout).
+static const vector<tuple<uint8_t, uintmax_t, uintmax_t, uintmax_t, bool, bool>>
+    models{
+        {8, 0x07, 0, 0, false, false},
+        {8, 0x39, 0, 0, true, true},
+        {16, 0x1021, 0, 0, false, false},
+        {16, 0x1021, 0xffff, 0, true, true},
+        {24, 0x100065b, 0x555555, 0, true, false},
+        {32, 0x4c11db7, 0, -1, false, false},
+        {32, 0x4c11db7, -1, -1, true, true},
+        {32, 0x1EDC6F41, -1, -1, true, true},
+        {64, 0x42F0E1EBA9EA3693, 0, 0, false, false},
+        {64, 0x42F0E1EBA9EA3693, -1, -1, true, true},
+        {5, 0x05, 0x1f, 0x1f, true, true},
+        {12, 0x80f, 0, 0, false, true},
+        {15, 0x4599, 0, 0, false, false},
+        {31, 0x4c11db7, -1, -1, false, false},
+    };
+
+static vector<uint8_t> random_data(size_t len) {
+  vector<uint8_t> data(len);
+  mt19937 gen(len);
+  for (auto &d : data) {
+    d = uint8_t(gen());
+  }
+  return data;
+}
+
+static bool init_model(::crcx_ctx *ctx, size_t i) {
+  auto &m = models[i];
+  return ::crcx_init(ctx, get<0>(m), get<1>(m), get<2>(m), get<3>(m),
+                     get<4>(m), get<5>(m));
+}
+
+TEST(Sanity, invalid_slices) {
+  static uintmax_t tables[CRCX_SLICES_MAX][256];
+  ::crcx_ctx ctx = {};
+  ASSERT_FALSE(::crcx_generate_slices(nullptr, tables, sizeof(tables), 8));
+  ASSERT_TRUE(::crcx_init(&ctx, 8, 0x07, 0, 0, false, false));
+  ASSERT_FALSE(::crcx_generate_slices(&ctx, tables, sizeof(tables), 3));
+  // a CRC-8 needs 8 tables of 256 bytes
+  ASSERT_FALSE(::crcx_generate_slices(&ctx, tables, 8 * 256 - 1, 8));
+  ASSERT_TRUE(::crcx_generate_slices(&ctx, tables, 8 * 256, 8));
+  ASSERT_FALSE(::crcx_generate_slices(&ctx, nullptr, sizeof(tables), 8));
+  ASSERT_TRUE(::crcx_generate_slices(&ctx, tables, sizeof(tables), 0));
+  ASSERT_EQ(ctx.slices, 0);
+}
+
+// this test shows that reflected tables give the standard check values
+// for the string "123456789"
+TEST(LibCRCx, reflected_check) {
+  const string msg = "123456789";
+  const vector<tuple<size_t, uintmax_t>> expected{
+      {1, 0x15},               // CRC-8/DARC
+      {3, 0x6f91},             // CRC-16/MCRF4XX
+      {6, 0xcbf43926},         // CRC-32/ISO-HDLC
+      {7, 0xe3069283},         // CRC-32/ISCSI
+      {9, 0x995dc9bbdf1939fa}, // CRC-64/XZ
+  };
+
+  for (auto &e : expected) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, get<0>(e)));
+    for (auto &c : msg) {
+      ::crcx_update(&ctx, c);
+    }
+    EXPECT_EQ(::crcx_fini(&ctx), get<1>(e)) << "model: " << get<0>(e);
+  }
+}
+
+// this test shows that slicing-by-N gives the same result as byte-wise
+TEST(LibCRCx, slicing_by_n) {
+  static uintmax_t tables[CRCX_SLICES_MAX][256];
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    for (uint8_t slices : {4, 8, 16}) {
+      ::crcx_ctx expected_ctx = {};
+      ::crcx_ctx actual_ctx = {};
+      ASSERT_TRUE(init_model(&expected_ctx, i));
+      ASSERT_TRUE(init_model(&actual_ctx, i));
+      ASSERT_TRUE(
+          ::crcx_generate_slices(&actual_ctx, tables, sizeof(tables), slices));
+      ASSERT_EQ(actual_ctx.slices, slices);
+
+      for (size_t len = 0; len < 100; ++len) {
+        auto data = random_data(len);
+        for (auto &d : data) {
+          ::crcx_update(&expected_ctx, d);
+        }
+        ASSERT_TRUE(::crcx(&actual_ctx, data.data(), data.size()));
+        ASSERT_EQ(::crcx_fini(&actual_ctx), ::crcx_fini(&expected_ctx))
+            << "model: " << i << " slices: " << unsigned(slices)
+            << " len: " << len;
+      }
+    }
+  }
+}
+
+// this test shows that folding with carry-less multiplication gives the same
+// result as byte-wise for any polynomial, when supported by the CPU
+TEST(LibCRCx, clmul) {
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx expected_ctx = {};
+    ::crcx_ctx actual_ctx = {};
+    ASSERT_TRUE(init_model(&expected_ctx, i));
+    ASSERT_TRUE(init_model(&actual_ctx, i));
+
+    for (size_t len = 0; len < 600; len += 7) {
+      auto data = random_data(len);
+      for (auto &d : data) {
+        ::crcx_update(&expected_ctx, d);
+      }
+      ASSERT_TRUE(::crcx(&actual_ctx, data.data(), data.size()));
+      ASSERT_EQ(::crcx_fini(&actual_ctx), ::crcx_fini(&expected_ctx))
+          << "model: " << i << " len: " << len
+          << " kernel: " << ::crcx_kernel_name(actual_ctx.kernel);
+    }
+  }
+}
+
+// this test shows that CRC-32C contexts are detected and give the same result
+// as byte-wise, including inputs that are long enough to be interleaved
+TEST(LibCRCx, crc32c) {
+  const string check = "123456789";
+
+  ::crcx_ctx expected_ctx = {};
+  ::crcx_ctx actual_ctx = {};
+  ASSERT_TRUE(::crcx_init(&expected_ctx, 32, 0x1EDC6F41, -1, -1, true, true));
+  ASSERT_TRUE(::crcx_init(&actual_ctx, 32, 0x1EDC6F41, -1, -1, true, true));
+
+  ASSERT_TRUE(::crcx(&actual_ctx, check.data(), check.size()));
+  EXPECT_EQ(::crcx_fini(&actual_ctx), 0xE3069283);
+
+  for (size_t len : {0, 1, 7, 8, 9, 767, 768, 769, 1000, 3 * 8192 - 1,
+                     3 * 8192, 3 * 8192 + 3 * 256 + 13, 100000}) {
+    auto data = random_data(len);
+    for (size_t offs = 0; offs < 3 && offs <= len; ++offs) {
+      for (size_t i = offs; i < len; ++i) {
+        ::crcx_update(&expected_ctx, data[i]);
+      }
+      ASSERT_TRUE(::crcx(&actual_ctx, data.data() + offs, len - offs));
+      ASSERT_EQ(::crcx_fini(&actual_ctx), ::crcx_fini(&expected_ctx))
+          << "len: " << len << " offs: " << offs
+          << " kernel: " << ::crcx_kernel_name(actual_ctx.kernel);
+    }
+  }
+}
+
+TEST(Sanity, kernel_of_invalid_ctx) {
+  ::crcx_ctx ctx = {};
+  ASSERT_EQ(::crcx_get_kernel(nullptr), CRCX_KERNEL_NONE);
+  ASSERT_EQ(::crcx_get_kernel(&ctx), CRCX_KERNEL_NONE);
+  ASSERT_FALSE(::crcx_set_kernel(&ctx, CRCX_KERNEL_TABLE));
+  ASSERT_FALSE(::crcx(&ctx, "W", 1));
+  ASSERT_FALSE(::crcx_init(&ctx, 8, 0, 0, 0, false, false));
+  ASSERT_EQ(::crcx_get_kernel(&ctx), CRCX_KERNEL_NONE);
+}
+
+// this test shows that every kernel that is available for a context gives
+// the same result
+TEST(LibCRCx, kernels) {
+  static uintmax_t tables[CRCX_SLICES_MAX][256];
+  const auto data = random_data(1000);
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, i));
+    ASSERT_NE(::crcx_get_kernel(&ctx), CRCX_KERNEL_NONE);
+    ASSERT_FALSE(::crcx_set_kernel(&ctx, CRCX_KERNEL_SLICING));
+    ASSERT_FALSE(::crcx_set_kernel(&ctx, CRCX_KERNEL_NONE));
+
+    ASSERT_TRUE(::crcx_set_kernel(&ctx, CRCX_KERNEL_TABLE));
+    ASSERT_TRUE(::crcx_generate_slices(&ctx, tables, sizeof(tables), 8));
+    ASSERT_EQ(::crcx_get_kernel(&ctx), CRCX_KERNEL_SLICING);
+
+    ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+    const uintmax_t expected = ::crcx_fini(&ctx);
+
+    for (auto kernel : {CRCX_KERNEL_TABLE, CRCX_KERNEL_SLICING,
+                        CRCX_KERNEL_CLMUL, CRCX_KERNEL_CRC32C}) {
+      if (!::crcx_set_kernel(&ctx, kernel)) {
+        continue;
+      }
+      ASSERT_EQ(::crcx_get_kernel(&ctx), kernel);
+      ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+      EXPECT_EQ(::crcx_fini(&ctx), expected)
+          << "model: " << i << " kernel: " << ::crcx_kernel_name(kernel);
+    }
+  }
+}
+
+// this test shows that combining the CRCs of two segments gives the CRC of
+// their concatenation
+TEST(LibCRCx, combine) {
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, i));
+
+    for (size_t len : {0, 1, 15, 100, 1000, 4099}) {
+      auto data = random_data(len);
+      ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+      uintmax_t expected_uintmax = ::crcx_fini(&ctx);
+
+      for (size_t split : {size_t(0), len / 3, len}) {
+        ASSERT_TRUE(::crcx(&ctx, data.data(), split));
+        uintmax_t crc1 = ::crcx_fini(&ctx);
+        ASSERT_TRUE(::crcx(&ctx, data.data() + split, len - split));
+        uintmax_t crc2 = ::crcx_fini(&ctx);
+
+        EXPECT_EQ(::crcx_combine(&ctx, crc1, crc2, len - split),
+                  expected_uintmax)
+            << "model: " << i << " len: " << len << " split: " << split;
+      }
+    }
+  }
+}
+
+// this test shows that the parallel computation gives the same result as
+// the serial one
+TEST(LibCRCx, parallel) {
+  auto data = random_data((5 << 20) + 77);
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, i));
+    ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+    uintmax_t expected_uintmax = ::crcx_fini(&ctx);
+
+    for (unsigned threads : {0, 1, 2, 3, 8}) {
+      ASSERT_TRUE(::crcx_parallel(&ctx, data.data(), data.size(), threads));
+      EXPECT_EQ(::crcx_fini(&ctx), expected_uintmax)
+          << "model: " << i << " threads: " << threads;
+    }
+  }
+}
+
+// this test shows that appending zeros in logarithmic time gives the same
+// result as processing them
+TEST(LibCRCx, zeros) {
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx expected_ctx = {};
+    ::crcx_ctx actual_ctx = {};
+    ASSERT_TRUE(init_model(&expected_ctx, i));
+    ASSERT_TRUE(init_model(&actual_ctx, i));
+
+    for (size_t len : {0, 1, 2, 7, 64, 1000, 65537}) {
+      auto data = random_data(len);
+      vector<uint8_t> zeros(len);
+      ASSERT_TRUE(::crcx(&expected_ctx, data.data(), data.size()));
+      ASSERT_TRUE(::crcx(&expected_ctx, zeros.data(), zeros.size()));
+      ASSERT_TRUE(::crcx(&actual_ctx, data.data(), data.size()));
+      ASSERT_TRUE(::crcx_zeros(&actual_ctx, len));
+      EXPECT_EQ(::crcx_fini(&actual_ctx), ::crcx_fini(&expected_ctx))
+          << "model: " << i << " len: " << len;
+    }
+  }
+}
+
+// this test shows that holes in sparse files are accounted for
+TEST(LibCRCx, sparse_file) {
+  char path[] = "/tmp/crcx-test-XXXXXX";
+  int fd = ::mkstemp(path);
+  ASSERT_NE(fd, -1);
+  ::unlink(path);
+
+  // data at the start, in the middle and at the end of a 16 MiB file
+  vector<uint8_t> contents(16 << 20);
+  for (size_t offset : {size_t(0), size_t(5 << 20) + 3, contents.size() - 100}) {
+    auto data = random_data(100);
+    ASSERT_EQ(::pwrite(fd, data.data(), data.size(), offset), 100);
+    copy(data.begin(), data.end(), contents.begin() + offset);
+  }
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, i));
+    ASSERT_TRUE(::crcx(&ctx, contents.data(), contents.size()));
+    uintmax_t expected_uintmax = ::crcx_fini(&ctx);
+
+    ASSERT_TRUE(::crcx_fd(&ctx, fd));
+    EXPECT_EQ(::crcx_fini(&ctx), expected_uintmax) << "model: " << i;
+  }
+
+  // a file that ends with a hole
+  ASSERT_EQ(::ftruncate(fd, 32 << 20), 0);
+  contents.resize(32 << 20);
+  ::crcx_ctx ctx = {};
+  ASSERT_TRUE(init_model(&ctx, 7));
+  ASSERT_TRUE(::crcx(&ctx, contents.data(), contents.size()));
+  uintmax_t expected_uintmax = ::crcx_fini(&ctx);
+  ASSERT_TRUE(::crcx_fd(&ctx, fd));
+  EXPECT_EQ(::crcx_fini(&ctx), expected_uintmax);
+
+  ::close(fd);
+
+  EXPECT_FALSE(::crcx_fd(&ctx, fd));
+}
+
+// this test shows that streams sharing one context give the same results as
+// separate contexts
+TEST(LibCRCx, streams) {
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, i));
+
+    ::crcx_stream streams[3];
+    for (auto &s : streams) {
+      ASSERT_TRUE(::crcx_stream_init(&s, &ctx));
+    }
+
+    // interleave the updates of all streams
+    auto data = random_data(1000);
+    for (size_t offset = 0; offset < data.size(); offset += 100) {
+      for (size_t s = 0; s < 3; ++s) {
+        ASSERT_TRUE(::crcx_stream_update(&streams[s], data.data() + offset, s + 1));
+      }
+    }
+
+    for (size_t s = 0; s < 3; ++s) {
+      ::crcx_ctx expected_ctx = {};
+      ASSERT_TRUE(init_model(&expected_ctx, i));
+      for (size_t offset = 0; offset < data.size(); offset += 100) {
+        ASSERT_TRUE(::crcx(&expected_ctx, data.data() + offset, s + 1));
+      }
+      EXPECT_EQ(::crcx_stream_fini(&streams[s]), ::crcx_fini(&expected_ctx))
+          << "model: " << i << " stream: " << s;
+    }
+  }
+}
+
+TEST(LibCRCx, stream_pool) {
+  ::crcx_ctx ctx = {};
+  ASSERT_TRUE(init_model(&ctx, 7));
+
+  ::crcx_stream storage[4];
+  ::crcx_pool pool;
+  ASSERT_TRUE(::crcx_pool_init(&pool, storage, ARRAY_SIZE(storage)));
+
+  vector<::crcx_stream *> streams;
+  for (size_t i = 0; i < ARRAY_SIZE(storage); ++i) {
+    streams.push_back(::crcx_pool_get(&pool, &ctx));
+    ASSERT_NE(streams.back(), nullptr);
+  }
+  ASSERT_EQ(::crcx_pool_get(&pool, &ctx), nullptr);
+  ASSERT_EQ(pool.used, ARRAY_SIZE(storage));
+
+  ASSERT_TRUE(::crcx_pool_put(&pool, streams[1]));
+  ASSERT_TRUE(::crcx_pool_put(&pool, streams[2]));
+  ASSERT_FALSE(::crcx_pool_put(&pool, &storage[0] + ARRAY_SIZE(storage)));
+  ASSERT_FALSE(::crcx_pool_put(
+      &pool, (::crcx_stream *)((uint8_t *)&storage[0] + 1)));
+
+  // streams that were put back are neither put back again nor used
+  ASSERT_FALSE(::crcx_pool_put(&pool, streams[2]));
+  ASSERT_FALSE(::crcx_stream_update(streams[1], "123456789", 9));
+  ASSERT_EQ(::crcx_stream_fini(streams[1]), uintmax_t(-1));
+  ASSERT_EQ(pool.used, ARRAY_SIZE(storage) - 2);
+
+  // streams are reused and reinitialized
+  auto s = ::crcx_pool_get(&pool, &ctx);
+  ASSERT_EQ(s, streams[2]);
+  ASSERT_TRUE(::crcx_stream_update(s, "123456789", 9));
+  EXPECT_EQ(::crcx_stream_fini(s), 0xe3069283);
+  ASSERT_EQ(::crcx_pool_get(&pool, &ctx), streams[1]);
+  ASSERT_EQ(::crcx_pool_get(&pool, &ctx), nullptr);
+}
+
+// this test shows that contexts initialized from the cache are identical to
+// freshly generated ones
+TEST(LibCRCx, cache) {
+  ::crcx_cache_stats before = {};
+  ::crcx_cache_stats after = {};
+
+  // a polynomial that no other test uses
+  ::crcx_ctx expected_ctx = {};
+  ::crcx_get_cache_stats(&before);
+  ASSERT_TRUE(::crcx_init(&expected_ctx, 40, 0x0004820009, 0, -1, true, true));
+  ::crcx_get_cache_stats(&after);
+  EXPECT_EQ(after.misses, before.misses + 1);
+  EXPECT_EQ(after.entries, before.entries + 1);
+  EXPECT_LE(after.entries, after.capacity);
+
+  // reflect_output does not affect the cached data
+  ::crcx_ctx actual_ctx = {};
+  ASSERT_TRUE(::crcx_init(&actual_ctx, 40, 0x0004820009, 0, -1, true, false));
+  ::crcx_get_cache_stats(&before);
+  EXPECT_EQ(before.hits, after.hits + 1);
+  EXPECT_EQ(before.misses, after.misses);
+
+  EXPECT_EQ(0, memcmp(actual_ctx.table64, expected_ctx.table64,
+                      sizeof(expected_ctx.table64)));
+  EXPECT_EQ(0, memcmp(actual_ctx.fold, expected_ctx.fold,
+                      sizeof(expected_ctx.fold)));
+  EXPECT_EQ(0, memcmp(actual_ctx.zeros, expected_ctx.zeros,
+                      sizeof(expected_ctx.zeros)));
+
+  // contexts initialized concurrently share one entry
+  vector<thread> threads;
+  vector<uintmax_t> results(8);
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&results, i] {
+      ::crcx_ctx ctx = {};
+      if (::crcx_init(&ctx, 24, 0x5d6dcb, 0xfedcba, 0, false, false)) {
+        ::crcx(&ctx, "123456789", 9);
+        results[i] = ::crcx_fini(&ctx);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (auto &r : results) {
+    EXPECT_EQ(r, 0x7979bd); // CRC-24/FLEXRAY-A
+  }
+}
+
+// this test shows that every model in the catalogue gives its check value
+TEST(LibCRCx, models) {
+  size_t count = 0;
+  const ::crcx_model *models = ::crcx_models(&count);
+  ASSERT_NE(models, nullptr);
+  ASSERT_GT(count, 0);
+
+  for (size_t i = 0; i < count; ++i) {
+    auto &m = models[i];
+    EXPECT_TRUE(::crcx_check_model(&m)) << m.name;
+
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(::crcx_init_model(&ctx, m.name)) << m.name;
+    ASSERT_TRUE(::crcx(&ctx, "123456789", 9));
+    EXPECT_EQ(::crcx_fini(&ctx), m.check) << m.name;
+  }
+}
+
+TEST(LibCRCx, find_model) {
+  auto m = ::crcx_find_model("CRC-32C");
+  ASSERT_NE(m, nullptr);
+  EXPECT_STREQ(m->name, "CRC-32/ISCSI");
+  EXPECT_EQ(m->check, 0xe3069283);
+
+  EXPECT_EQ(::crcx_find_model("crc-32/iso-hdlc"), ::crcx_find_model("CRC-32"));
+  EXPECT_EQ(::crcx_find_model("CRC-16/CCITT-FALSE"),
+            ::crcx_find_model("CRC-16/IBM-3740"));
+
+  ::crcx_ctx ctx = {};
+  EXPECT_EQ(::crcx_find_model("CRC-32/"), nullptr);
+  EXPECT_EQ(::crcx_find_model(nullptr), nullptr);
+  EXPECT_FALSE(::crcx_init_model(&ctx, "CRC-99"));
+  EXPECT_FALSE(::crcx_init_model(nullptr, "CRC-32C"));
+}
+
+// a bit at a time, as a reference for CRCs of any width
+static uintmax_t bitwise(size_t i, const vector<uint8_t> &data,
+                         size_t nbits = -1) {
+  auto &m = models[i];
+  const uint8_t n = get<0>(m);
+  const uintmax_t mask = n == 64 ? uintmax_t(-1) : (uintmax_t(1) << n) - 1;
+  uintmax_t lfsr = get<2>(m) & mask;
+  nbits = min(nbits, 8 * data.size());
+  for (size_t j = 0; j < nbits / 8 + (0 != nbits % 8); ++j) {
+    const uint8_t d = data[j];
+    for (size_t bit = 0; bit < min<size_t>(8, nbits - 8 * j); ++bit) {
+      const bool in = get<4>(m) ? (d >> bit) & 1 : (d >> (7 - bit)) & 1;
+      const bool out = (lfsr >> (n - 1)) & 1;
+      lfsr = (lfsr << 1) & mask;
+      if (in != out) {
+        lfsr ^= get<1>(m);
+      }
+    }
+  }
+  if (get<5>(m)) {
+    lfsr = ::crcx_reflect(lfsr, n);
+  }
+  return (lfsr ^ get<3>(m)) & mask;
+}
+
+// this test shows that every kernel gives the same result as a bit-at-a-time
+// CRC for widths that are not a multiple of 8
+TEST(LibCRCx, arbitrary_width) {
+  static uintmax_t tables[CRCX_SLICES_MAX][256];
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    if (0 == get<0>(models[i]) % 8) {
+      continue;
+    }
+
+    for (size_t len : {0, 1, 7, 64, 1000}) {
+      const auto data = random_data(len);
+      const uintmax_t expected = bitwise(i, data);
+
+      ::crcx_ctx ctx = {};
+      ASSERT_TRUE(init_model(&ctx, i));
+      ASSERT_TRUE(::crcx_generate_slices(&ctx, tables, sizeof(tables), 8));
+      for (auto kernel :
+           {CRCX_KERNEL_TABLE, CRCX_KERNEL_SLICING, CRCX_KERNEL_CLMUL}) {
+        if (!::crcx_set_kernel(&ctx, kernel)) {
+          continue;
+        }
+        ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+        EXPECT_EQ(::crcx_fini(&ctx), expected)
+            << "model: " << i << " len: " << len
+            << " kernel: " << ::crcx_kernel_name(kernel);
+      }
+    }
+  }
+}
+
+// this test shows that the CRC of any number of bits gives the same result as
+// a bit-at-a-time CRC, with or without reflected input
+TEST(LibCRCx, update_bits) {
+  const auto data = random_data(40);
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, i));
+    for (size_t nbits = 0; nbits <= 8 * data.size(); nbits += 3) {
+      ASSERT_TRUE(::crcx_update_bits(&ctx, data.data(), nbits));
+      EXPECT_EQ(::crcx_fini(&ctx), bitwise(i, data, nbits))
+          << "model: " << i << " nbits: " << nbits;
+    }
+  }
+
+  // a USB token with address 0x15 and endpoint 0xe
+  ::crcx_ctx ctx = {};
+  const uint8_t token[] = {0x15, 0x07};
+  ASSERT_TRUE(::crcx_init_model(&ctx, "CRC-5/USB"));
+  ASSERT_TRUE(::crcx_update_bits(&ctx, token, 11));
+  EXPECT_EQ(::crcx_fini(&ctx), 0x1d);
+
+  ASSERT_FALSE(::crcx_update_bits(nullptr, token, 11));
+}
+
+// this test shows that a batch of messages of different lengths and contexts
+// gives the same results as one message at a time
+TEST(LibCRCx, batch) {
+  static uintmax_t tables[CRCX_SLICES_MAX][256];
+  vector<::crcx_ctx> ctxs(models.size(), ::crcx_ctx{});
+  vector<::crcx_stream> streams(200);
+  vector<::crcx_msg> msgs(streams.size());
+  vector<vector<uint8_t>> data(streams.size());
+  vector<uintmax_t> expected(streams.size());
+  vector<uintmax_t> actual(streams.size());
+  mt19937 gen(streams.size());
+
+  for (size_t i = 0; i < ctxs.size(); ++i) {
+    ASSERT_TRUE(init_model(&ctxs[i], i));
+  }
+  ASSERT_TRUE(::crcx_set_kernel(&ctxs[0], CRCX_KERNEL_TABLE));
+  ASSERT_TRUE(::crcx_generate_slices(&ctxs[6], tables, sizeof(tables), 8));
+
+  for (size_t i = 0; i < streams.size(); ++i) {
+    // runs of messages share a context
+    auto &ctx = ctxs[i / 16 % ctxs.size()];
+    data[i] = random_data(gen() % 300);
+    ASSERT_TRUE(::crcx(&ctx, data[i].data(), data[i].size()));
+    expected[i] = ::crcx_fini(&ctx);
+
+    ASSERT_TRUE(::crcx_stream_init(&streams[i], &ctx));
+    msgs[i] = {&streams[i], data[i].data(), data[i].size()};
+  }
+
+  ASSERT_TRUE(::crcx_batch(msgs.data(), msgs.size(), actual.data()));
+  EXPECT_EQ(actual, expected);
+
+  // streams remain open without results
+  ASSERT_TRUE(::crcx_batch(msgs.data(), msgs.size(), nullptr));
+  for (size_t i = 0; i < streams.size(); ++i) {
+    ASSERT_TRUE(::crcx_stream_update(&streams[i], data[i].data(),
+                                     data[i].size()));
+    auto &ctx = *streams[i].ctx;
+    ::crcx_ctx check = ctx;
+    ASSERT_TRUE(::crcx(&check, data[i].data(), data[i].size()));
+    ASSERT_TRUE(::crcx(&check, data[i].data(), data[i].size()));
+    EXPECT_EQ(::crcx_stream_fini(&streams[i]), ::crcx_fini(&check)) << i;
+  }
+
+  ASSERT_TRUE(::crcx_batch(nullptr, 0, nullptr));
+  ASSERT_FALSE(::crcx_batch(nullptr, 1, nullptr));
+  msgs[1].stream = nullptr;
+  ASSERT_FALSE(::crcx_batch(msgs.data(), msgs.size(), actual.data()));
+}
+
+// this test shows that scattered data gives the same result as contiguous
+// data, for segments of any length including empty ones, also with a NULL base
+TEST(LibCRCx, scatter_gather) {
+  const auto data = random_data(5000);
+  mt19937 gen(data.size());
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    ::crcx_ctx ctx = {};
+    ASSERT_TRUE(init_model(&ctx, i));
+    ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+    const uintmax_t expected = ::crcx_fini(&ctx);
+
+    for (size_t max : {1, 16, 100, 1000}) {
+      vector<iovec> iov = {{nullptr, 0}};
+      for (size_t off = 0; off < data.size();) {
+        size_t len = min<size_t>(gen() % (max + 1), data.size() - off);
+        iov.push_back({(void *)&data[off], len});
+        off += len;
+        if (0 == gen() % 4) {
+          iov.push_back({nullptr, 0});
+        }
+      }
+      iov.push_back({nullptr, 0});
+
+      for (auto kernel : {CRCX_KERNEL_TABLE, CRCX_KERNEL_CLMUL}) {
+        if (!::crcx_set_kernel(&ctx, kernel)) {
+          continue;
+        }
+        ASSERT_TRUE(::crcx_v(&ctx, iov.data(), int(iov.size())));
+        EXPECT_EQ(::crcx_fini(&ctx), expected)
+            << "model: " << i << " max: " << max
+            << " kernel: " << ::crcx_kernel_name(kernel);
+      }
+    }
+  }
+
+  ::crcx_ctx ctx = {};
+  ASSERT_FALSE(::crcx_v(&ctx, nullptr, 0));
+  ASSERT_TRUE(init_model(&ctx, 0));
+  ASSERT_TRUE(::crcx_v(&ctx, nullptr, 0));
+  ASSERT_FALSE(::crcx_v(&ctx, nullptr, 1));
+  ASSERT_FALSE(::crcx_v(nullptr, nullptr, 0));
+}
+
+// this test shows that files are checksummed by path, and that pipes and
+// files of unknown size (in procfs) are read until the end
+TEST(LibCRCx, file) {
+  char path[] = "/tmp/crcx-test-XXXXXX";
+  int fd = ::mkstemp(path);
+  ASSERT_NE(fd, -1);
+
+  // more than one mapping, with a partial page at the end
+  const auto data = random_data((64 << 20) + 12345);
+  ASSERT_EQ(::write(fd, data.data(), data.size()), ssize_t(data.size()));
+  ::close(fd);
+
+  ::crcx_ctx ctx = {};
+  ASSERT_TRUE(init_model(&ctx, 7));
+  ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+  const uintmax_t expected = ::crcx_fini(&ctx);
+  ASSERT_TRUE(::crcx_file(&ctx, path));
+  EXPECT_EQ(::crcx_fini(&ctx), expected);
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  thread writer([&] {
+    ASSERT_EQ(::write(fds[1], data.data(), 100000), 100000);
+    ::close(fds[1]);
+  });
+  ASSERT_TRUE(::crcx(&ctx, data.data(), 100000));
+  const uintmax_t expected_pipe = ::crcx_fini(&ctx);
+  ASSERT_TRUE(::crcx_fd(&ctx, fds[0]));
+  EXPECT_EQ(::crcx_fini(&ctx), expected_pipe);
+  writer.join();
+  ::close(fds[0]);
+
+  ::unlink(path);
+  EXPECT_FALSE(::crcx_file(&ctx, path));
+  EXPECT_EQ(errno, ENOENT);
+  EXPECT_FALSE(::crcx_file(&ctx, nullptr));
+
+  // /proc/self/cmdline has a size of 0 but is not empty
+  vector<uint8_t> cmdline(4096);
+  fd = ::open("/proc/self/cmdline", O_RDONLY);
+  if (-1 == fd) {
+    return;
+  }
+  cmdline.resize(::read(fd, cmdline.data(), cmdline.size()));
+  ::close(fd);
+  ASSERT_FALSE(cmdline.empty());
+  ASSERT_TRUE(::crcx(&ctx, cmdline.data(), cmdline.size()));
+  const uintmax_t expected_proc = ::crcx_fini(&ctx);
+  ASSERT_TRUE(::crcx_file(&ctx, "/proc/self/cmdline"));
+  EXPECT_EQ(::crcx_fini(&ctx), expected_proc);
+}
+
+// this test shows that many files of different sizes give the same results
+// with every I/O engine, including files that are missing or empty
+TEST(LibCRCx, files) {
+  vector<string> names;
+  vector<uintmax_t> expected;
+  ::crcx_ctx ctx = {};
+  ASSERT_TRUE(init_model(&ctx, 7));
+
+  for (size_t len : {0, 1, 1000, 128 << 10, (128 << 10) + 1, 3 << 20}) {
+    for (int k = 0; k < 8; ++k) {
+      char path[] = "/tmp/crcx-test-XXXXXX";
+      int fd = ::mkstemp(path);
+      ASSERT_NE(fd, -1);
+      const auto data = random_data(len + k);
+      ASSERT_EQ(::write(fd, data.data(), data.size()), ssize_t(data.size()));
+      ::close(fd);
+
+      names.push_back(path);
+      ASSERT_TRUE(::crcx(&ctx, data.data(), data.size()));
+      expected.push_back(::crcx_fini(&ctx));
+    }
+  }
+
+  vector<const char *> paths;
+  for (auto &name : names) {
+    paths.push_back(name.c_str());
+  }
+
+  for (auto io : {CRCX_IO_AUTO, CRCX_IO_URING, CRCX_IO_THREADS}) {
+    for (unsigned depth : {0, 1, 4}) {
+      vector<uintmax_t> crcs(paths.size());
+      vector<int> errors(paths.size(), -1);
+      if (!::crcx_files(&ctx, paths.data(), paths.size(), crcs.data(),
+                        errors.data(), depth, io)) {
+        // io_uring may not be available
+        ASSERT_EQ(io, CRCX_IO_URING);
+        ASSERT_EQ(errno, ENOSYS);
+        continue;
+      }
+      EXPECT_EQ(crcs, expected) << "io: " << io << " depth: " << depth;
+      EXPECT_EQ(errors, vector<int>(paths.size(), 0));
+    }
+  }
+
+  for (auto &name : names) {
+    ::unlink(name.c_str());
+  }
+
+  // the other files are still checksummed
+  paths.push_back("/proc/self/cmdline");
+  vector<uintmax_t> crcs(paths.size());
+  vector<int> errors(paths.size());
+  for (auto io : {CRCX_IO_AUTO, CRCX_IO_THREADS}) {
+    EXPECT_FALSE(::crcx_files(&ctx, paths.data(), paths.size(), crcs.data(),
+                              errors.data(), 0, io));
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_EQ(errors.front(), ENOENT);
+    EXPECT_EQ(crcs.front(), uintmax_t(-1));
+    EXPECT_EQ(errors.back(), 0);
+  }
+
+  EXPECT_TRUE(::crcx_files(&ctx, nullptr, 0, nullptr, nullptr, 0,
+                           CRCX_IO_AUTO));
+  EXPECT_FALSE(::crcx_files(nullptr, paths.data(), paths.size(), crcs.data(),
+                            nullptr, 0, CRCX_IO_AUTO));
+}